@@ -80,8 +80,8 @@ Usage(char** argv, const std::string& msg = std::string())
   std::cerr << "\t-u <URL for inference service>" << std::endl;
   std::cerr << "\t-t <client timeout in microseconds>" << std::endl;
   std::cerr << "\t-H <HTTP header>" << std::endl;
-  std::cerr << "\t-i <none|gzip|deflate>" << std::endl;
-  std::cerr << "\t-o <none|gzip|deflate>" << std::endl;
+  std::cerr << "\t-i <none|gzip|deflate|zstd|lz4>" << std::endl;
+  std::cerr << "\t-o <none|gzip|deflate|zstd|lz4>" << std::endl;
   std::cerr << std::endl;
   std::cerr << "\t--verify-peer" << std::endl;
   std::cerr << "\t--verify-host" << std::endl;
@@ -167,6 +167,12 @@ main(int argc, char** argv)
         } else if (arg == "deflate") {
           request_compression_algorithm =
               tc::InferenceServerHttpClient::CompressionType::DEFLATE;
+        } else if (arg == "zstd") {
+          request_compression_algorithm =
+              tc::InferenceServerHttpClient::CompressionType::ZSTD;
+        } else if (arg == "lz4") {
+          request_compression_algorithm =
+              tc::InferenceServerHttpClient::CompressionType::LZ4;
         }
         break;
       }
@@ -178,6 +184,12 @@ main(int argc, char** argv)
         } else if (arg == "deflate") {
           response_compression_algorithm =
               tc::InferenceServerHttpClient::CompressionType::DEFLATE;
+        } else if (arg == "zstd") {
+          response_compression_algorithm =
+              tc::InferenceServerHttpClient::CompressionType::ZSTD;
+        } else if (arg == "lz4") {
+          response_compression_algorithm =
+              tc::InferenceServerHttpClient::CompressionType::LZ4;
         }
         break;
       }
@@ -0,0 +1,214 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <getopt.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "http_client.h"
+
+namespace tc = triton::client;
+
+#define FAIL_IF_ERR(X, MSG)                                        \
+  {                                                                \
+    tc::Error err = (X);                                           \
+    if (!err.IsOk()) {                                             \
+      std::cerr << "error: " << (MSG) << ": " << err << std::endl; \
+      exit(1);                                                     \
+    }                                                              \
+  }
+
+namespace {
+
+void
+Usage(char** argv, const std::string& msg = std::string())
+{
+  if (!msg.empty()) {
+    std::cerr << "error: " << msg << std::endl;
+  }
+
+  std::cerr << "Usage: " << argv[0] << " [options]" << std::endl;
+  std::cerr << "\t-u <URL for inference service over TCP>" << std::endl;
+  std::cerr << "\t-s <path of the Unix domain socket of the inference service>"
+            << std::endl;
+  std::cerr << "\t-n <number of requests>" << std::endl;
+  std::cerr << std::endl;
+  std::cerr << "Runs the same inference requests over loopback TCP and over "
+               "the Unix domain socket and reports the latency of each."
+            << std::endl;
+
+  exit(1);
+}
+
+// Run 'request_count' synchronous inferences on 'client' and report the
+// latency percentiles under 'label'.
+void
+Benchmark(
+    const std::string& label, tc::InferenceServerHttpClient* client,
+    const tc::InferOptions& options, const std::vector<tc::InferInput*>& inputs,
+    const size_t request_count)
+{
+  // Warm up the connection before measuring
+  for (size_t i = 0; i < 10; ++i) {
+    tc::InferResult* result;
+    FAIL_IF_ERR(
+        client->Infer(&result, options, inputs),
+        "unable to run model over " + label);
+    FAIL_IF_ERR(result->RequestStatus(), "inference failed over " + label);
+    delete result;
+  }
+
+  std::vector<uint64_t> latencies_ns;
+  latencies_ns.reserve(request_count);
+  for (size_t i = 0; i < request_count; ++i) {
+    const auto start = std::chrono::steady_clock::now();
+    tc::InferResult* result;
+    FAIL_IF_ERR(
+        client->Infer(&result, options, inputs),
+        "unable to run model over " + label);
+    const auto end = std::chrono::steady_clock::now();
+    FAIL_IF_ERR(result->RequestStatus(), "inference failed over " + label);
+    delete result;
+    latencies_ns.push_back(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)
+            .count());
+  }
+
+  std::sort(latencies_ns.begin(), latencies_ns.end());
+  uint64_t total_ns = 0;
+  for (const auto latency_ns : latencies_ns) {
+    total_ns += latency_ns;
+  }
+  const auto percentile_us = [&latencies_ns](const double percentile) {
+    const size_t idx = std::min(
+        latencies_ns.size() - 1,
+        static_cast<size_t>(latencies_ns.size() * percentile / 100));
+    return latencies_ns[idx] / 1000;
+  };
+
+  std::cout << label << ": " << request_count << " requests" << std::endl;
+  std::cout << "\tavg latency " << (total_ns / request_count / 1000) << " usec"
+            << std::endl;
+  std::cout << "\tp50 latency " << percentile_us(50) << " usec" << std::endl;
+  std::cout << "\tp90 latency " << percentile_us(90) << " usec" << std::endl;
+  std::cout << "\tp99 latency " << percentile_us(99) << " usec" << std::endl;
+}
+
+}  // namespace
+
+int
+main(int argc, char** argv)
+{
+  std::string url("localhost:8000");
+  std::string socket_path;
+  size_t request_count = 1000;
+
+  // Parse commandline...
+  int opt;
+  while ((opt = getopt(argc, argv, "u:s:n:")) != -1) {
+    switch (opt) {
+      case 'u':
+        url = optarg;
+        break;
+      case 's':
+        socket_path = optarg;
+        break;
+      case 'n':
+        request_count = std::stoul(optarg);
+        break;
+      case '?':
+        Usage(argv);
+        break;
+    }
+  }
+
+  if (socket_path.empty()) {
+    Usage(argv, "-s must be specified");
+  }
+  if (request_count == 0) {
+    Usage(argv, "-n must be greater than 0");
+  }
+
+  // We use a simple model that takes 2 input tensors of 16 integers
+  // each and returns 2 output tensors of 16 integers each.
+  std::string model_name = "simple";
+
+  std::unique_ptr<tc::InferenceServerHttpClient> tcp_client;
+  FAIL_IF_ERR(
+      tc::InferenceServerHttpClient::Create(&tcp_client, url),
+      "unable to create http client");
+  // The 'unix://' scheme sends all the requests over the Unix domain
+  // socket. Equivalently, HttpTransportOptions::unix_socket_path may be set.
+  std::unique_ptr<tc::InferenceServerHttpClient> uds_client;
+  FAIL_IF_ERR(
+      tc::InferenceServerHttpClient::Create(
+          &uds_client, "unix://" + socket_path),
+      "unable to create http client over the Unix domain socket");
+
+  std::vector<int32_t> input0_data(16);
+  std::vector<int32_t> input1_data(16);
+  for (size_t i = 0; i < 16; ++i) {
+    input0_data[i] = i;
+    input1_data[i] = 1;
+  }
+
+  std::vector<int64_t> shape{1, 16};
+
+  tc::InferInput* input0;
+  tc::InferInput* input1;
+  FAIL_IF_ERR(
+      tc::InferInput::Create(&input0, "INPUT0", shape, "INT32"),
+      "unable to get INPUT0");
+  std::shared_ptr<tc::InferInput> input0_ptr(input0);
+  FAIL_IF_ERR(
+      tc::InferInput::Create(&input1, "INPUT1", shape, "INT32"),
+      "unable to get INPUT1");
+  std::shared_ptr<tc::InferInput> input1_ptr(input1);
+
+  FAIL_IF_ERR(
+      input0_ptr->AppendRaw(
+          reinterpret_cast<uint8_t*>(&input0_data[0]),
+          input0_data.size() * sizeof(int32_t)),
+      "unable to set data for INPUT0");
+  FAIL_IF_ERR(
+      input1_ptr->AppendRaw(
+          reinterpret_cast<uint8_t*>(&input1_data[0]),
+          input1_data.size() * sizeof(int32_t)),
+      "unable to set data for INPUT1");
+
+  tc::InferOptions options(model_name);
+  std::vector<tc::InferInput*> inputs = {input0_ptr.get(), input1_ptr.get()};
+
+  Benchmark("TCP " + url, tcp_client.get(), options, inputs, request_count);
+  Benchmark(
+      "Unix domain socket " + socket_path, uds_client.get(), options, inputs,
+      request_count);
+
+  return 0;
+}
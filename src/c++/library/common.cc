@@ -45,13 +45,301 @@ operator<<(std::ostream& out, const Error& err)
 
 //==============================================================================
 
+constexpr size_t LatencyHistogram::kSubBucketBits;
+constexpr size_t LatencyHistogram::kMaxValueBits;
+constexpr size_t LatencyHistogram::kBucketCount;
+constexpr size_t LatencyHistogram::kShardCount;
+
+namespace {
+
+// The shard of the histograms that the calling thread records into.
+// Threads are assigned shards in turn on their first recording.
+size_t
+HistogramShardIndex(const size_t shard_count)
+{
+  static std::atomic<size_t> next_thread_idx(0);
+  thread_local size_t thread_idx =
+      next_thread_idx.fetch_add(1, std::memory_order_relaxed);
+  return thread_idx % shard_count;
+}
+
+}  // namespace
+
+LatencyHistogram::LatencyHistogram() : shards_(new Shard[kShardCount]())
+{
+}
+
+size_t
+LatencyHistogram::BucketIndex(const uint64_t value_ns)
+{
+  const uint64_t sub_bucket_count = (uint64_t(1) << kSubBucketBits);
+  if (value_ns < sub_bucket_count) {
+    return value_ns;
+  }
+
+  // The position of the most significant bit selects the power of two,
+  // the bits after it select the linear bucket within it.
+  size_t msb = 0;
+  for (uint64_t v = value_ns; v > 1; v >>= 1) {
+    ++msb;
+  }
+  if (msb >= kMaxValueBits) {
+    return kBucketCount - 1;
+  }
+  const size_t shift = msb - kSubBucketBits;
+  return ((msb - kSubBucketBits + 1) << kSubBucketBits) +
+         ((value_ns >> shift) - sub_bucket_count);
+}
+
+uint64_t
+LatencyHistogram::BucketUpperBound(const size_t index)
+{
+  const uint64_t sub_bucket_count = (uint64_t(1) << kSubBucketBits);
+  if (index < sub_bucket_count) {
+    return index;
+  }
+
+  const size_t shift = (index >> kSubBucketBits) - 1;
+  const uint64_t sub_bucket = index & (sub_bucket_count - 1);
+  return ((sub_bucket_count + sub_bucket + 1) << shift) - 1;
+}
+
+void
+LatencyHistogram::Record(const uint64_t value_ns)
+{
+  Shard& shard = shards_[HistogramShardIndex(kShardCount)];
+  shard.count_.fetch_add(1, std::memory_order_relaxed);
+  shard.sum_ns_.fetch_add(value_ns, std::memory_order_relaxed);
+  shard.buckets_[BucketIndex(value_ns)].fetch_add(
+      1, std::memory_order_relaxed);
+  uint64_t max_ns = shard.max_ns_.load(std::memory_order_relaxed);
+  while ((value_ns > max_ns) &&
+         !shard.max_ns_.compare_exchange_weak(
+             max_ns, value_ns, std::memory_order_relaxed)) {
+  }
+}
+
+uint64_t
+LatencyHistogram::Count() const
+{
+  uint64_t count = 0;
+  for (size_t i = 0; i < kShardCount; ++i) {
+    count += shards_[i].count_.load(std::memory_order_relaxed);
+  }
+  return count;
+}
+
+uint64_t
+LatencyHistogram::Sum() const
+{
+  uint64_t sum_ns = 0;
+  for (size_t i = 0; i < kShardCount; ++i) {
+    sum_ns += shards_[i].sum_ns_.load(std::memory_order_relaxed);
+  }
+  return sum_ns;
+}
+
+LatencyPercentiles
+LatencyHistogram::Percentiles() const
+{
+  std::vector<uint64_t> buckets(kBucketCount, 0);
+  LatencyPercentiles percentiles;
+  uint64_t count = 0;
+  for (size_t i = 0; i < kShardCount; ++i) {
+    const Shard& shard = shards_[i];
+    for (size_t b = 0; b < kBucketCount; ++b) {
+      const uint64_t bucket_count =
+          shard.buckets_[b].load(std::memory_order_relaxed);
+      buckets[b] += bucket_count;
+      count += bucket_count;
+    }
+    percentiles.max_ns = (std::max)(
+        percentiles.max_ns, shard.max_ns_.load(std::memory_order_relaxed));
+  }
+  percentiles.count = count;
+  if (count == 0) {
+    return percentiles;
+  }
+
+  // The rank of each percentile, rounded up so that the percentile covers
+  // at least that fraction of the latencies.
+  const uint64_t p50_rank = (count * 50 + 99) / 100;
+  const uint64_t p90_rank = (count * 90 + 99) / 100;
+  const uint64_t p99_rank = (count * 99 + 99) / 100;
+  uint64_t seen = 0;
+  for (size_t b = 0; b < kBucketCount; ++b) {
+    if (buckets[b] == 0) {
+      continue;
+    }
+    const uint64_t previous_seen = seen;
+    seen += buckets[b];
+    // The last bucket also holds every latency beyond the tracked range
+    const uint64_t upper_bound =
+        (b == (kBucketCount - 1))
+            ? percentiles.max_ns
+            : (std::min)(BucketUpperBound(b), percentiles.max_ns);
+    if ((previous_seen < p50_rank) && (seen >= p50_rank)) {
+      percentiles.p50_ns = upper_bound;
+    }
+    if ((previous_seen < p90_rank) && (seen >= p90_rank)) {
+      percentiles.p90_ns = upper_bound;
+    }
+    if ((previous_seen < p99_rank) && (seen >= p99_rank)) {
+      percentiles.p99_ns = upper_bound;
+    }
+  }
+
+  return percentiles;
+}
+
+//==============================================================================
+
+ThreadPoolCallbackExecutor::ThreadPoolCallbackExecutor(size_t thread_count)
+    : exiting_(false)
+{
+  thread_count = (std::max)(thread_count, size_t(1));
+  for (size_t i = 0; i < thread_count; ++i) {
+    threads_.emplace_back(&ThreadPoolCallbackExecutor::Run, this);
+  }
+}
+
+ThreadPoolCallbackExecutor::~ThreadPoolCallbackExecutor()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    exiting_ = true;
+  }
+  cv_.notify_all();
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+void
+ThreadPoolCallbackExecutor::Execute(std::function<void()> task)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.emplace_back(std::move(task));
+  }
+  cv_.notify_one();
+}
+
+void
+ThreadPoolCallbackExecutor::Run()
+{
+  while (true) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this] { return exiting_ || !tasks_.empty(); });
+      // Drain the pending tasks before exiting
+      if (tasks_.empty()) {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    task();
+  }
+}
+
+//==============================================================================
+
+InferenceServerClient::~InferenceServerClient()
+{
+  // The derived clients have already waited for the callbacks, only the
+  // ones handed off while they were shutting down can still be pending.
+  WaitForPendingCallbacks();
+}
+
+void
+InferenceServerClient::WaitForPendingCallbacks()
+{
+  std::unique_lock<std::mutex> lock(callback_mutex_);
+  callback_cv_.wait(lock, [this] { return pending_callback_count_ == 0; });
+}
+
 Error
 InferenceServerClient::ClientInferStat(InferStat* infer_stat) const
 {
-  *infer_stat = infer_stat_;
+  *infer_stat = InferStat();
+  infer_stat->handle_pool_hit_count =
+      handle_pool_hit_count_.load(std::memory_order_relaxed);
+  infer_stat->handle_pool_miss_count =
+      handle_pool_miss_count_.load(std::memory_order_relaxed);
+  infer_stat->completed_request_count = request_time_hist_.Count();
+  infer_stat->cumulative_total_request_time_ns = request_time_hist_.Sum();
+  infer_stat->cumulative_send_time_ns = send_time_hist_.Sum();
+  infer_stat->cumulative_receive_time_ns = recv_time_hist_.Sum();
+  infer_stat->cumulative_callback_queue_time_ns =
+      callback_queue_time_hist_.Sum();
   return Error::Success;
 }
 
+Error
+InferenceServerClient::ClientInferStat(
+    InferStat* infer_stat, InferLatencyStat* latency_stat) const
+{
+  latency_stat->total_request = request_time_hist_.Percentiles();
+  latency_stat->send = send_time_hist_.Percentiles();
+  latency_stat->receive = recv_time_hist_.Percentiles();
+  latency_stat->callback_queue = callback_queue_time_hist_.Percentiles();
+  latency_stat->first_response = first_response_time_hist_.Percentiles();
+  latency_stat->inter_response = inter_response_time_hist_.Percentiles();
+  return ClientInferStat(infer_stat);
+}
+
+Error
+InferenceServerClient::SetCallbackExecutor(
+    std::shared_ptr<CallbackExecutor> executor)
+{
+  {
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    callback_executor_.swap(executor);
+  }
+  // The previous executor is released outside of the lock as destroying
+  // it runs its pending callbacks, which acquire the lock.
+  executor.reset();
+  return Error::Success;
+}
+
+void
+InferenceServerClient::ExecuteCallback(
+    const std::shared_ptr<InferRequest>& request, InferResult* result)
+{
+  std::shared_ptr<CallbackExecutor> executor;
+  {
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    executor = callback_executor_;
+    if (executor != nullptr) {
+      pending_callback_count_++;
+    }
+  }
+  if (executor == nullptr) {
+    request->Timer().CaptureTimestamp(RequestTimers::Kind::CALLBACK_START);
+    request->callback_(result);
+    return;
+  }
+
+  executor->Execute([this, request, result]() {
+    RequestTimers& timer = request->Timer();
+    timer.CaptureTimestamp(RequestTimers::Kind::CALLBACK_START);
+    const uint64_t queue_time_ns = timer.Duration(
+        RequestTimers::Kind::REQUEST_END, RequestTimers::Kind::CALLBACK_START);
+    if (queue_time_ns != std::numeric_limits<uint64_t>::max()) {
+      callback_queue_time_hist_.Record(queue_time_ns);
+    }
+
+    request->callback_(result);
+
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    if (--pending_callback_count_ == 0) {
+      callback_cv_.notify_all();
+    }
+  });
+}
+
 Error
 InferenceServerClient::UpdateInferStat(const RequestTimers& timer)
 {
@@ -97,14 +385,24 @@ InferenceServerClient::UpdateInferStat(const RequestTimers& timer)
              : ""));
   }
 
-  infer_stat_.completed_request_count++;
-  infer_stat_.cumulative_total_request_time_ns += request_time_ns;
-  infer_stat_.cumulative_send_time_ns += send_time_ns;
-  infer_stat_.cumulative_receive_time_ns += recv_time_ns;
+  request_time_hist_.Record(request_time_ns);
+  send_time_hist_.Record(send_time_ns);
+  recv_time_hist_.Record(recv_time_ns);
 
   return Error::Success;
 }
 
+void
+InferenceServerClient::UpdateResponseStat(
+    const uint64_t latency_ns, const bool first_response)
+{
+  if (first_response) {
+    first_response_time_hist_.Record(latency_ns);
+  } else {
+    inter_response_time_hist_.Record(latency_ns);
+  }
+}
+
 //==============================================================================
 
 Error
@@ -301,9 +599,49 @@ InferRequestedOutput::UnsetSharedMemory()
   return Error::Success;
 }
 
+Error
+InferRequestedOutput::SetDestinationBuffer(void* buf, const size_t byte_size)
+{
+  if (io_type_ == SHARED_MEMORY) {
+    return Error(
+        "The output '" + name_ + "' has already been set with shared memory.");
+  }
+  if (buf == nullptr) {
+    return Error("The destination buffer for '" + name_ + "' is null.");
+  }
+
+  dst_buf_ = buf;
+  dst_byte_size_ = byte_size;
+
+  return Error::Success;
+}
+
+Error
+InferRequestedOutput::UnsetDestinationBuffer()
+{
+  dst_buf_ = nullptr;
+  dst_byte_size_ = 0;
+
+  return Error::Success;
+}
+
+Error
+InferRequestedOutput::DestinationBuffer(void** buf, size_t* byte_size) const
+{
+  if (dst_buf_ == nullptr) {
+    return Error("The output has not been set with a destination buffer.");
+  }
+
+  *buf = dst_buf_;
+  *byte_size = dst_byte_size_;
+
+  return Error::Success;
+}
+
 InferRequestedOutput::InferRequestedOutput(
     const std::string& name, const size_t class_count)
-    : name_(name), class_count_(class_count), io_type_(NONE)
+    : name_(name), class_count_(class_count), io_type_(NONE),
+      dst_buf_(nullptr), dst_byte_size_(0)
 {
 }
 
@@ -324,4 +662,523 @@ InferRequestedOutput::SharedMemoryInfo(
 
 //==============================================================================
 
+Error
+PreparedRequest::SetInputs(const std::vector<InferInput*>& inputs)
+{
+  inputs_ = inputs;
+  input_byte_sizes_.clear();
+  for (const auto input : inputs_) {
+    size_t byte_size = 0;
+    if (!input->IsSharedMemory()) {
+      Error err = input->ByteSize(&byte_size);
+      if (!err.IsOk()) {
+        return err;
+      }
+    }
+    input_byte_sizes_.push_back(byte_size);
+  }
+
+  return Error::Success;
+}
+
+Error
+PreparedRequest::CheckInputByteSizes() const
+{
+  for (size_t i = 0; i < inputs_.size(); ++i) {
+    if (inputs_[i]->IsSharedMemory()) {
+      continue;
+    }
+    size_t byte_size;
+    Error err = inputs_[i]->ByteSize(&byte_size);
+    if (!err.IsOk()) {
+      return err;
+    }
+    if (byte_size != input_byte_sizes_[i]) {
+      return Error(
+          "input '" + inputs_[i]->Name() + "' has byte size " +
+          std::to_string(byte_size) + " but the request was prepared with " +
+          std::to_string(input_byte_sizes_[i]));
+    }
+  }
+
+  return Error::Success;
+}
+
+//==============================================================================
+
+namespace {
+
+// The result of a request of a batch, the rows of the result of the
+// batched request that belong to the request.
+class BatchedInferResult : public InferResult {
+ public:
+  BatchedInferResult(
+      std::shared_ptr<InferResult> batch_result, const std::string& request_id,
+      const size_t offset, const size_t batch_size,
+      const size_t total_batch_size)
+      : batch_result_(std::move(batch_result)), request_id_(request_id),
+        offset_(offset), batch_size_(batch_size),
+        total_batch_size_(total_batch_size)
+  {
+  }
+
+  // The result of a request of a batch that couldn't be sent.
+  BatchedInferResult(const Error& request_status, const std::string& request_id)
+      : request_status_(request_status), request_id_(request_id), offset_(0),
+        batch_size_(0), total_batch_size_(0)
+  {
+  }
+
+  Error ModelName(std::string* name) const override
+  {
+    return (batch_result_ == nullptr) ? request_status_
+                                      : batch_result_->ModelName(name);
+  }
+
+  Error ModelVersion(std::string* version) const override
+  {
+    return (batch_result_ == nullptr) ? request_status_
+                                      : batch_result_->ModelVersion(version);
+  }
+
+  Error Id(std::string* id) const override
+  {
+    *id = request_id_;
+    return Error::Success;
+  }
+
+  Error Shape(const std::string& output_name, std::vector<int64_t>* shape)
+      const override
+  {
+    if (batch_result_ == nullptr) {
+      return request_status_;
+    }
+    Error err = batch_result_->Shape(output_name, shape);
+    if (!err.IsOk()) {
+      return err;
+    }
+    if (shape->empty() || ((*shape)[0] != (int64_t)total_batch_size_)) {
+      return NotBatchedError(output_name);
+    }
+    (*shape)[0] = batch_size_;
+    return Error::Success;
+  }
+
+  Error Datatype(
+      const std::string& output_name, std::string* datatype) const override
+  {
+    return (batch_result_ == nullptr)
+               ? request_status_
+               : batch_result_->Datatype(output_name, datatype);
+  }
+
+  Error RawData(
+      const std::string& output_name, const uint8_t** buf,
+      size_t* byte_size) const override
+  {
+    if (batch_result_ == nullptr) {
+      return request_status_;
+    }
+    Error err = batch_result_->RawData(output_name, buf, byte_size);
+    if (!err.IsOk()) {
+      return err;
+    }
+    std::string datatype;
+    err = batch_result_->Datatype(output_name, &datatype);
+    if (!err.IsOk()) {
+      return err;
+    }
+
+    if (datatype != "BYTES") {
+      if ((*byte_size % total_batch_size_) != 0) {
+        return NotBatchedError(output_name);
+      }
+      const size_t row_byte_size = *byte_size / total_batch_size_;
+      *buf += row_byte_size * offset_;
+      *byte_size = row_byte_size * batch_size_;
+      return Error::Success;
+    }
+
+    // The elements of BYTES outputs are serialized with their length
+    // first so the rows of the request are found by walking the elements.
+    std::vector<size_t> element_offsets;
+    size_t pos = 0;
+    while ((pos + sizeof(uint32_t)) <= *byte_size) {
+      element_offsets.push_back(pos);
+      uint32_t element_byte_size;
+      std::copy(
+          *buf + pos, *buf + pos + sizeof(uint32_t),
+          reinterpret_cast<uint8_t*>(&element_byte_size));
+      pos += sizeof(uint32_t) + element_byte_size;
+    }
+    element_offsets.push_back(pos);
+    const size_t element_count = element_offsets.size() - 1;
+    if ((pos != *byte_size) || ((element_count % total_batch_size_) != 0)) {
+      return NotBatchedError(output_name);
+    }
+    const size_t row_element_count = element_count / total_batch_size_;
+    const size_t start = element_offsets[row_element_count * offset_];
+    const size_t end =
+        element_offsets[row_element_count * (offset_ + batch_size_)];
+    *buf += start;
+    *byte_size = end - start;
+    return Error::Success;
+  }
+
+  Error StringData(
+      const std::string& output_name,
+      std::vector<std::string>* string_result) const override
+  {
+    if (batch_result_ == nullptr) {
+      return request_status_;
+    }
+    std::vector<std::string> batch_strings;
+    Error err = batch_result_->StringData(output_name, &batch_strings);
+    if (!err.IsOk()) {
+      return err;
+    }
+    if ((batch_strings.size() % total_batch_size_) != 0) {
+      return NotBatchedError(output_name);
+    }
+    const size_t row_element_count = batch_strings.size() / total_batch_size_;
+    string_result->assign(
+        std::make_move_iterator(
+            batch_strings.begin() + row_element_count * offset_),
+        std::make_move_iterator(
+            batch_strings.begin() +
+            row_element_count * (offset_ + batch_size_)));
+    return Error::Success;
+  }
+
+  std::string DebugString() const override
+  {
+    return (batch_result_ == nullptr) ? request_status_.Message()
+                                      : batch_result_->DebugString();
+  }
+
+  Error RequestStatus() const override
+  {
+    return (batch_result_ == nullptr) ? request_status_
+                                      : batch_result_->RequestStatus();
+  }
+
+ private:
+  Error NotBatchedError(const std::string& output_name) const
+  {
+    return Error(
+        "output '" + output_name + "' of the batched request doesn't have " +
+        "the batch of " + std::to_string(total_batch_size_) +
+        " as its first dimension");
+  }
+
+  std::shared_ptr<InferResult> batch_result_;
+  Error request_status_;
+  std::string request_id_;
+  // The rows of the request in the batch
+  size_t offset_;
+  size_t batch_size_;
+  size_t total_batch_size_;
+};
+
+}  // namespace
+
+// The requests held to be sent as a single batched request.
+class InferBatcher::Batch {
+ public:
+  struct Request {
+    InferenceServerClient::OnCompleteFn callback_;
+    std::string request_id_;
+    // The rows of the request in the batch
+    size_t offset_;
+    size_t batch_size_;
+  };
+
+  Batch(
+      const InferOptions& options,
+      const std::chrono::steady_clock::time_point deadline)
+      : options_(options), batch_size_(0), deadline_(deadline)
+  {
+    // The requests keep their own ids, the batched request has none.
+    options_.request_id_.clear();
+  }
+
+  // Append the rows of a request to the batched inputs, the data of the
+  // request is referenced rather than copied.
+  void Add(
+      InferenceServerClient::OnCompleteFn callback,
+      const std::string& request_id, const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs,
+      const size_t batch_size)
+  {
+    if (inputs_.empty()) {
+      for (const auto input : inputs) {
+        InferInput* batch_input;
+        InferInput::Create(
+            &batch_input, input->Name(), input->Shape(), input->Datatype());
+        inputs_.emplace_back(batch_input);
+      }
+      for (const auto output : outputs) {
+        InferRequestedOutput* batch_output;
+        InferRequestedOutput::Create(
+            &batch_output, output->Name(), output->ClassificationCount());
+        outputs_.emplace_back(batch_output);
+      }
+    }
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      for (size_t b = 0; b < inputs[i]->bufs_.size(); ++b) {
+        inputs_[i]->AppendRaw(
+            inputs[i]->bufs_[b], inputs[i]->buf_byte_sizes_[b]);
+      }
+    }
+    requests_.push_back(
+        Request{std::move(callback), request_id, batch_size_, batch_size});
+    batch_size_ += batch_size;
+  }
+
+  InferOptions options_;
+  std::vector<std::unique_ptr<InferInput>> inputs_;
+  std::vector<std::unique_ptr<InferRequestedOutput>> outputs_;
+  std::vector<Request> requests_;
+  size_t batch_size_;
+  // The time the batch is sent at if it isn't full by then
+  const std::chrono::steady_clock::time_point deadline_;
+};
+
+Error
+InferBatcher::Create(
+    std::unique_ptr<InferBatcher>* batcher, AsyncInferFn async_infer,
+    const InferBatcherOptions& options)
+{
+  if (async_infer == nullptr) {
+    return Error("the function sending the requests must be provided");
+  }
+  if (options.max_batch_size == 0) {
+    return Error("the maximum batch size must be at least 1");
+  }
+
+  batcher->reset(new InferBatcher(async_infer, options));
+  return Error::Success;
+}
+
+InferBatcher::InferBatcher(
+    AsyncInferFn async_infer, const InferBatcherOptions& options)
+    : async_infer_(async_infer), options_(options), inflight_count_(0),
+      exiting_(false)
+{
+  worker_ = std::thread(&InferBatcher::Run, this);
+}
+
+InferBatcher::~InferBatcher()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    exiting_ = true;
+  }
+  cv_.notify_all();
+  worker_.join();
+
+  Flush();
+  std::unique_lock<std::mutex> lock(mutex_);
+  cv_.wait(lock, [this] { return (inflight_count_ == 0); });
+}
+
+bool
+InferBatcher::BatchKey(
+    const InferOptions& options, const std::vector<InferInput*>& inputs,
+    const std::vector<const InferRequestedOutput*>& outputs, std::string* key)
+{
+  if (inputs.empty() || (options.sequence_id_ != 0) ||
+      !options.sequence_id_str_.empty()) {
+    return false;
+  }
+
+  // The options and the tensors, apart from the batch dimension, must be
+  // the same for the requests to be batched together.
+  std::string batch_key = options.model_name_ + '\0' + options.model_version_ +
+                          '\0' + std::to_string(options.priority_) + '\0' +
+                          std::to_string(options.server_timeout_) + '\0' +
+                          std::to_string(options.client_timeout_);
+  const int64_t batch_size = inputs.front()->Shape().empty()
+                                 ? 0
+                                 : inputs.front()->Shape().front();
+  for (const auto input : inputs) {
+    const std::vector<int64_t>& shape = input->Shape();
+    if (input->IsSharedMemory() || (batch_size <= 0) || shape.empty() ||
+        (shape.front() != batch_size)) {
+      return false;
+    }
+    batch_key += '\0' + input->Name() + '\0' + input->Datatype();
+    for (size_t i = 1; i < shape.size(); ++i) {
+      batch_key += ',' + std::to_string(shape[i]);
+    }
+  }
+  batch_key += '\0';
+  for (const auto output : outputs) {
+    if (output->IsSharedMemory() || output->HasDestinationBuffer()) {
+      return false;
+    }
+    batch_key += '\0' + output->Name() + ',' +
+                 std::to_string(output->ClassificationCount());
+  }
+
+  *key = std::move(batch_key);
+  return true;
+}
+
+Error
+InferBatcher::AsyncInfer(
+    InferenceServerClient::OnCompleteFn callback, const InferOptions& options,
+    const std::vector<InferInput*>& inputs,
+    const std::vector<const InferRequestedOutput*>& outputs)
+{
+  if (callback == nullptr) {
+    return Error(
+        "Callback function must be provided along with AsyncInfer() call.");
+  }
+
+  std::string key;
+  if (!BatchKey(options, inputs, outputs, &key) ||
+      ((size_t)inputs.front()->Shape().front() > options_.max_batch_size)) {
+    return async_infer_(callback, options, inputs, outputs);
+  }
+  const size_t batch_size = inputs.front()->Shape().front();
+
+  // The batches completed by the request, sent once the lock is released.
+  std::vector<std::shared_ptr<Batch>> full_batches;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = batches_.find(key);
+    if ((it != batches_.end()) &&
+        ((it->second->batch_size_ + batch_size) > options_.max_batch_size)) {
+      full_batches.push_back(std::move(it->second));
+      batches_.erase(it);
+      it = batches_.end();
+    }
+    if (it == batches_.end()) {
+      it = batches_
+               .emplace(
+                   key, std::make_shared<Batch>(
+                            options, std::chrono::steady_clock::now() +
+                                         std::chrono::microseconds(
+                                             options_.max_queue_delay_us)))
+               .first;
+      cv_.notify_all();
+    }
+    it->second->Add(
+        std::move(callback), options.request_id_, inputs, outputs,
+        batch_size);
+    if (it->second->batch_size_ == options_.max_batch_size) {
+      full_batches.push_back(std::move(it->second));
+      batches_.erase(it);
+    }
+  }
+
+  for (auto& batch : full_batches) {
+    Send(std::move(batch));
+  }
+  return Error::Success;
+}
+
+void
+InferBatcher::Flush()
+{
+  std::vector<std::shared_ptr<Batch>> batches;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& batch : batches_) {
+      batches.push_back(std::move(batch.second));
+    }
+    batches_.clear();
+  }
+
+  for (auto& batch : batches) {
+    Send(std::move(batch));
+  }
+}
+
+void
+InferBatcher::Run()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!exiting_) {
+    if (batches_.empty()) {
+      cv_.wait(lock);
+      continue;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    auto next_deadline = (std::chrono::steady_clock::time_point::max)();
+    std::vector<std::shared_ptr<Batch>> expired_batches;
+    for (auto it = batches_.begin(); it != batches_.end();) {
+      if (it->second->deadline_ <= now) {
+        expired_batches.push_back(std::move(it->second));
+        it = batches_.erase(it);
+      } else {
+        next_deadline = (std::min)(next_deadline, it->second->deadline_);
+        ++it;
+      }
+    }
+
+    if (expired_batches.empty()) {
+      cv_.wait_until(lock, next_deadline);
+    } else {
+      lock.unlock();
+      for (auto& batch : expired_batches) {
+        Send(std::move(batch));
+      }
+      lock.lock();
+    }
+  }
+}
+
+void
+InferBatcher::Send(std::shared_ptr<Batch> batch)
+{
+  std::vector<InferInput*> inputs;
+  for (auto& input : batch->inputs_) {
+    std::vector<int64_t> shape = input->Shape();
+    shape[0] = batch->batch_size_;
+    input->SetShape(shape);
+    inputs.push_back(input.get());
+  }
+  std::vector<const InferRequestedOutput*> outputs;
+  for (const auto& output : batch->outputs_) {
+    outputs.push_back(output.get());
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++inflight_count_;
+  }
+  // Notified with the lock held so that the batcher, which waits for the
+  // batched requests to complete, can't be destroyed before it returns.
+  const auto complete = [this]() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    --inflight_count_;
+    cv_.notify_all();
+  };
+
+  // The batch is kept alive until the request completes, as its inputs may
+  // be read while the request is in flight.
+  Error err = async_infer_(
+      [batch, complete](InferResult* result) {
+        std::shared_ptr<InferResult> batch_result(result);
+        for (const auto& request : batch->requests_) {
+          request.callback_(new BatchedInferResult(
+              batch_result, request.request_id_, request.offset_,
+              request.batch_size_, batch->batch_size_));
+        }
+        complete();
+      },
+      batch->options_, inputs, outputs);
+  if (!err.IsOk()) {
+    for (const auto& request : batch->requests_) {
+      request.callback_(new BatchedInferResult(err, request.request_id_));
+    }
+    complete();
+  }
+}
+
+//==============================================================================
+
 }}  // namespace triton::client
@@ -28,12 +28,15 @@
 /// \file
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <cstring>
+#include <deque>
 #include <functional>
 #include <iostream>
 #include <list>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -106,14 +109,177 @@ struct InferStat {
   /// response is completely received.
   uint64_t cumulative_receive_time_ns;
 
+  /// Number of asynchronous requests that reused a pooled transfer
+  /// handle. Only reported by clients that pool handles (HTTP).
+  size_t handle_pool_hit_count;
+
+  /// Number of asynchronous requests that had to create a new transfer
+  /// handle because no pooled handle was available.
+  size_t handle_pool_miss_count;
+
+  /// Time from the end of the request until its completion callback
+  /// starts running, i.e. the time spent waiting in the callback
+  /// executor. Always 0 when the callbacks are run inline.
+  uint64_t cumulative_callback_queue_time_ns;
+
   /// Create a new InferStat object with zero-ed statistics.
   InferStat()
       : completed_request_count(0), cumulative_total_request_time_ns(0),
-        cumulative_send_time_ns(0), cumulative_receive_time_ns(0)
+        cumulative_send_time_ns(0), cumulative_receive_time_ns(0),
+        handle_pool_hit_count(0), handle_pool_miss_count(0),
+        cumulative_callback_queue_time_ns(0)
   {
   }
 };
 
+//==============================================================================
+/// Latency percentiles of one phase of the completed requests. The
+/// percentiles are the upper bounds of histogram buckets that are at
+/// most 1/16 of their value wide, so they overestimate the exact
+/// percentile by less than 6.25%. The maximum is exact.
+///
+struct LatencyPercentiles {
+  /// Number of requests recorded.
+  size_t count;
+  uint64_t p50_ns;
+  uint64_t p90_ns;
+  uint64_t p99_ns;
+  uint64_t max_ns;
+
+  LatencyPercentiles() : count(0), p50_ns(0), p90_ns(0), p99_ns(0), max_ns(0)
+  {
+  }
+};
+
+//==============================================================================
+/// Latency distribution of each phase of the completed requests, the
+/// phases are the same as the cumulative times of InferStat.
+///
+struct InferLatencyStat {
+  /// Time from the request start until the response is completely
+  /// received.
+  LatencyPercentiles total_request;
+
+  /// Time from the request start until the last byte is sent.
+  LatencyPercentiles send;
+
+  /// Time from receiving first byte of the response until the
+  /// response is completely received.
+  LatencyPercentiles receive;
+
+  /// Time from the end of the request until its completion callback
+  /// starts running. Only recorded when the callbacks are run on a
+  /// callback executor.
+  LatencyPercentiles callback_queue;
+
+  /// Time from the request start until its first response is received.
+  /// Only recorded for the requests sent on gRPC streams, where a request
+  /// to a decoupled model may receive many responses.
+  LatencyPercentiles first_response;
+
+  /// Time between the consecutive responses of a request. Only recorded
+  /// for the requests sent on gRPC streams.
+  LatencyPercentiles inter_response;
+};
+
+//==============================================================================
+/// A histogram of latencies in nanoseconds with log-linear buckets: each
+/// power of two is split into 16 linear buckets. Recording is lock-free,
+/// each thread records into one of a few shards with relaxed atomic
+/// counters so that requests completed on different threads don't
+/// contend. Reads merge the shards and may miss the recordings that are
+/// in progress.
+///
+class LatencyHistogram {
+ public:
+  LatencyHistogram();
+
+  /// Record a latency.
+  /// \param value_ns The latency in nanoseconds.
+  void Record(const uint64_t value_ns);
+
+  /// \return The number of latencies recorded.
+  uint64_t Count() const;
+
+  /// \return The sum of the latencies recorded, in nanoseconds.
+  uint64_t Sum() const;
+
+  /// \return The percentiles of the latencies recorded.
+  LatencyPercentiles Percentiles() const;
+
+ private:
+  // Each power of two is split into 2^kSubBucketBits buckets, values
+  // past 2^kMaxValueBits ns (about 18 minutes) share the last bucket.
+  static constexpr size_t kSubBucketBits = 4;
+  static constexpr size_t kMaxValueBits = 40;
+  static constexpr size_t kBucketCount =
+      ((kMaxValueBits - kSubBucketBits + 1) << kSubBucketBits);
+  static constexpr size_t kShardCount = 4;
+
+  struct Shard {
+    std::atomic<uint64_t> count_;
+    std::atomic<uint64_t> sum_ns_;
+    std::atomic<uint64_t> max_ns_;
+    std::atomic<uint64_t> buckets_[kBucketCount];
+  };
+
+  static size_t BucketIndex(const uint64_t value_ns);
+  static uint64_t BucketUpperBound(const size_t index);
+
+  std::unique_ptr<Shard[]> shards_;
+};
+
+//==============================================================================
+/// An interface for the executor that runs the completion callbacks of
+/// asynchronous requests. Users may provide their own implementation to
+/// run the callbacks on an existing thread pool or event loop.
+///
+class CallbackExecutor {
+ public:
+  virtual ~CallbackExecutor() = default;
+
+  /// Run 'task', possibly on a different thread. Must not wait for
+  /// 'task' to complete unless the task is run on the calling thread.
+  /// \param task The task to be executed.
+  virtual void Execute(std::function<void()> task) = 0;
+};
+
+//==============================================================================
+/// A CallbackExecutor that runs the callbacks on the network thread that
+/// completed the request. This is the default behavior of the clients.
+///
+class InlineCallbackExecutor : public CallbackExecutor {
+ public:
+  void Execute(std::function<void()> task) override { task(); }
+};
+
+//==============================================================================
+/// A CallbackExecutor that runs the callbacks on a fixed number of
+/// threads, so that a slow callback doesn't delay the handling of other
+/// in-flight responses. Callbacks are started in completion order but may
+/// run concurrently.
+///
+class ThreadPoolCallbackExecutor : public CallbackExecutor {
+ public:
+  /// Create an executor backed by 'thread_count' threads.
+  /// \param thread_count The number of threads, must be at least 1.
+  explicit ThreadPoolCallbackExecutor(size_t thread_count);
+
+  /// Run the pending tasks and stop the threads.
+  ~ThreadPoolCallbackExecutor();
+
+  void Execute(std::function<void()> task) override;
+
+ private:
+  void Run();
+
+  std::vector<std::thread> threads_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::function<void()>> tasks_;
+  bool exiting_;
+};
+
 //==============================================================================
 /// The base class for InferenceServerClients
 ///
@@ -123,20 +289,54 @@ class InferenceServerClient {
   using OnMultiCompleteFn = std::function<void(std::vector<InferResult*>)>;
 
   explicit InferenceServerClient(bool verbose)
-      : verbose_(verbose), exiting_(false)
+      : verbose_(verbose), exiting_(false), handle_pool_hit_count_(0),
+        handle_pool_miss_count_(0), pending_callback_count_(0)
   {
   }
 
-  virtual ~InferenceServerClient() = default;
+  /// Waits for the callbacks that were handed to the callback executor
+  /// during the destruction of the derived client to complete.
+  virtual ~InferenceServerClient();
 
   /// Obtain the cumulative inference statistics of the client.
   /// \param Returns the InferStat object holding current statistics.
   /// \return Error object indicating success or failure.
   Error ClientInferStat(InferStat* infer_stat) const;
 
+  /// Obtain the cumulative inference statistics of the client along with
+  /// the latency percentiles of each phase of the requests.
+  /// \param infer_stat Returns the InferStat object holding current
+  /// statistics.
+  /// \param latency_stat Returns the latency percentiles of each phase.
+  /// \return Error object indicating success or failure.
+  Error ClientInferStat(
+      InferStat* infer_stat, InferLatencyStat* latency_stat) const;
+
+  /// Set the executor that runs the completion callbacks of asynchronous
+  /// requests. By default the callbacks are run inline on the thread that
+  /// completed the request. May be called while requests are in flight,
+  /// the callbacks already handed to the previous executor still run on it.
+  /// \param executor The executor to use, nullptr restores the default
+  /// inline behavior.
+  /// \return Error object indicating success or failure.
+  Error SetCallbackExecutor(std::shared_ptr<CallbackExecutor> executor);
+
  protected:
-  // Update the infer stat with the given timer
+  // Record the given timer into the latency histograms. Lock-free, may be
+  // called concurrently from any thread.
   Error UpdateInferStat(const RequestTimers& timer);
+  // Run the completion callback of 'request' with 'result' on the
+  // callback executor. 'request' is kept alive until the callback returns.
+  void ExecuteCallback(
+      const std::shared_ptr<InferRequest>& request, InferResult* result);
+  // Wait for the callbacks handed to the callback executor to complete.
+  // Must be called first by the destructor of the derived clients, so the
+  // callbacks never run on a partially destroyed client.
+  void WaitForPendingCallbacks();
+  // Record the latency of a response of a streaming request, measured
+  // from the request start for its first response or from the previous
+  // response otherwise.
+  void UpdateResponseStat(const uint64_t latency_ns, const bool first_response);
   // Enables verbose operation in the client.
   bool verbose_;
 
@@ -149,8 +349,29 @@ class InferenceServerClient {
   // signal for worker thread to stop
   bool exiting_;
 
-  // The inference statistic of the current client
-  InferStat infer_stat_;
+  // The number of asynchronous requests that reused a pooled transfer
+  // handle or had to create one. Relaxed atomics as they are updated by
+  // the transfer threads while ClientInferStat() may read them.
+  std::atomic<size_t> handle_pool_hit_count_;
+  std::atomic<size_t> handle_pool_miss_count_;
+
+ private:
+  // The latency of each phase of the completed requests
+  LatencyHistogram request_time_hist_;
+  LatencyHistogram send_time_hist_;
+  LatencyHistogram recv_time_hist_;
+  LatencyHistogram callback_queue_time_hist_;
+  LatencyHistogram first_response_time_hist_;
+  LatencyHistogram inter_response_time_hist_;
+
+  // The executor of the completion callbacks, nullptr to run them inline
+  std::shared_ptr<CallbackExecutor> callback_executor_;
+  // Number of callbacks handed to 'callback_executor_' that haven't
+  // completed, the client can't be destroyed until it drops to 0.
+  size_t pending_callback_count_;
+  // Protects 'callback_executor_' and 'pending_callback_count_'
+  std::mutex callback_mutex_;
+  std::condition_variable callback_cv_;
 };
 
 //==============================================================================
@@ -161,7 +382,7 @@ struct InferOptions {
       : model_name_(model_name), model_version_(""), request_id_(""),
         sequence_id_(0), sequence_id_str_(""), sequence_start_(false),
         sequence_end_(false), priority_(0), server_timeout_(0),
-        client_timeout_(0)
+        client_timeout_(0), triton_enable_empty_final_response_(false)
   {
   }
   /// The name of the model to run inference.
@@ -215,6 +436,12 @@ struct InferOptions {
   // requests. Instead see 'stream_timeout' argument in
   // InferenceServerGrpcClient::StartStream().
   uint64_t client_timeout_;
+  /// Whether the server should send an empty response flagged as final
+  /// once a request to a decoupled model has no more responses. Only
+  /// honored for requests sent on gRPC streams, where the final flag lets
+  /// the client complete the statistics of a request on its last response
+  /// rather than its first. Default value is false.
+  bool triton_enable_empty_final_response_;
 };
 
 //==============================================================================
@@ -330,6 +557,7 @@ class InferInput {
 #ifdef TRITON_INFERENCE_SERVER_CLIENT_CLASS
   friend class TRITON_INFERENCE_SERVER_CLIENT_CLASS;
 #endif
+  friend class InferBatcher;
   InferInput(
       const std::string& name, const std::vector<int64_t>& dims,
       const std::string& datatype);
@@ -421,10 +649,42 @@ class InferRequestedOutput {
   Error SharedMemoryInfo(
       std::string* name, size_t* byte_size, size_t* offset) const;
 
+  /// Set a caller-owned buffer that the output tensor data is written
+  /// into as the response is received, instead of being accumulated
+  /// in the response buffer. InferResult::RawData() then returns a
+  /// pointer into this buffer. The buffer must remain valid until the
+  /// request is completed. If the output data is larger than
+  /// 'byte_size' it is returned in the response buffer as usual. The
+  /// option is honored by the HTTP client for outputs returned as
+  /// binary data and is ignored by the GRPC client.
+  /// \param buf The buffer to write the output tensor data to.
+  /// \param byte_size The size of the buffer in bytes.
+  /// \return Error object indicating success or failure of the
+  /// request.
+  Error SetDestinationBuffer(void* buf, const size_t byte_size);
+
+  /// Clears the buffer set by the last call to
+  /// InferRequestedOutput::SetDestinationBuffer().
+  /// \return Error object indicating success or failure of the
+  /// request.
+  Error UnsetDestinationBuffer();
+
+  /// \return true if this output is being written to a caller-owned
+  /// buffer.
+  bool HasDestinationBuffer() const { return (dst_buf_ != nullptr); }
+
+  /// Get information about the caller-owned buffer being used for
+  /// this output.
+  /// \param buf Returns the buffer.
+  /// \param byte_size Returns the size of the buffer in bytes.
+  /// \return Error object indicating success or failure.
+  Error DestinationBuffer(void** buf, size_t* byte_size) const;
+
  private:
 #ifdef TRITON_INFERENCE_SERVER_CLIENT_CLASS
   friend class TRITON_INFERENCE_SERVER_CLIENT_CLASS;
 #endif
+  friend class InferBatcher;
 
   explicit InferRequestedOutput(
       const std::string& name, const size_t class_count = 0);
@@ -438,6 +698,10 @@ class InferRequestedOutput {
   std::string shm_name_;
   size_t shm_byte_size_;
   size_t shm_offset_;
+
+  // Used only if the output is written to a caller-owned buffer
+  void* dst_buf_;
+  size_t dst_byte_size_;
 };
 
 //==============================================================================
@@ -513,6 +777,154 @@ class InferResult {
   virtual Error RequestStatus() const = 0;
 };
 
+//==============================================================================
+/// A PreparedRequest holds the parts of an inference request that are the
+/// same for every call, such as the model, the tensor metadata, the
+/// requested outputs and the headers, serialized once by the PrepareRequest()
+/// function of a client. The request can then be sent any number of times by
+/// the client that prepared it, with only the per-call fields of
+/// InferOptions and the current data of the inputs being filled in on each
+/// call.
+///
+class PreparedRequest {
+ public:
+  virtual ~PreparedRequest() = default;
+
+  /// Returns the name of the model the request is prepared for.
+  /// \return The model name.
+  const std::string& ModelName() const { return model_name_; }
+
+ protected:
+  PreparedRequest(const std::string& model_name) : model_name_(model_name) {}
+
+  // Record the inputs of the request along with their current byte size.
+  Error SetInputs(const std::vector<InferInput*>& inputs);
+  // Return an error if the byte size of the non shared memory inputs is
+  // different from when the request was prepared, as it is part of the
+  // serialized request.
+  Error CheckInputByteSizes() const;
+
+  // The inputs of the request and, for the inputs not in shared memory,
+  // their byte size when the request was prepared.
+  std::vector<InferInput*> inputs_;
+  std::vector<size_t> input_byte_sizes_;
+
+ private:
+  std::string model_name_;
+};
+
+//==============================================================================
+/// Structure to hold options for InferBatcher.
+///
+struct InferBatcherOptions {
+  explicit InferBatcherOptions() : max_batch_size(8), max_queue_delay_us(100)
+  {
+  }
+  /// The maximum size of the first dimension of a batched request,
+  /// usually the max_batch_size of the model. A request that alone
+  /// exceeds it is sent without batching.
+  size_t max_batch_size;
+  /// The maximum time, in microseconds, a request is held waiting for
+  /// other requests to be batched with.
+  uint64_t max_queue_delay_us;
+};
+
+//==============================================================================
+/// An InferBatcher coalesces asynchronous inferences into batched
+/// requests to cut the number of calls made to the server. The requests
+/// to the same model with the same options and the same tensors, apart
+/// from the size of their first dimension, are held until
+/// 'max_batch_size' is reached or for at most 'max_queue_delay_us'. Their
+/// inputs are then concatenated along the first dimension, without
+/// copying the input data, into a single request. The result of that
+/// request is split back into one InferResult per request. Hence the
+/// batcher must only be used for models that support batching.
+///
+/// The requests that belong to a sequence or use shared memory or
+/// destination buffers are sent without batching. As with AsyncInfer(),
+/// the inputs of a request must stay valid until its callback is invoked.
+/// The buffers of the results of batched requests are shared, they stay
+/// valid until all the results of the batch are deleted. The batcher must
+/// be destroyed before the client it sends the requests through.
+///
+/// \code
+///   std::unique_ptr<InferBatcher> batcher;
+///   client->CreateInferBatcher(&batcher, InferBatcherOptions());
+///   batcher->AsyncInfer(callback, options, inputs, outputs);
+///   ...
+/// \endcode
+///
+class InferBatcher {
+ public:
+  /// The function sending a request asynchronously, usually the
+  /// AsyncInfer() function of a client.
+  using AsyncInferFn = std::function<Error(
+      InferenceServerClient::OnCompleteFn callback,
+      const InferOptions& options, const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs)>;
+
+  /// Create a batcher that sends the batched requests with 'async_infer'.
+  /// \param batcher Returns a new InferBatcher object.
+  /// \param async_infer The function sending the requests.
+  /// \param options The options of the batcher.
+  /// \return Error object indicating success or failure.
+  static Error Create(
+      std::unique_ptr<InferBatcher>* batcher, AsyncInferFn async_infer,
+      const InferBatcherOptions& options = InferBatcherOptions());
+
+  /// Sends the requests that are held and waits for all the batched
+  /// requests to complete.
+  ~InferBatcher();
+
+  /// Run an asynchronous inference, batched with the other requests of
+  /// the same model. See the AsyncInfer() function of the clients.
+  /// \param callback The callback function to be invoked on request
+  /// completion, with the result of this request only.
+  /// \param options The options for inference request.
+  /// \param inputs The vector of InferInput describing the model inputs,
+  /// the first dimension of each input is the batch dimension.
+  /// \param outputs Optional vector of InferRequestedOutput describing how
+  /// the output must be returned.
+  /// \return Error object indicating success or failure of the request.
+  Error AsyncInfer(
+      InferenceServerClient::OnCompleteFn callback,
+      const InferOptions& options, const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs =
+          std::vector<const InferRequestedOutput*>());
+
+  /// Send the requests that are held without waiting for their delay to
+  /// expire.
+  void Flush();
+
+ private:
+  class Batch;
+
+  InferBatcher(AsyncInferFn async_infer, const InferBatcherOptions& options);
+  // Return in 'key' the key of the batches the request can be added to,
+  // false if the request can't be batched.
+  static bool BatchKey(
+      const InferOptions& options, const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs,
+      std::string* key);
+  // Send the batches whose delay expired.
+  void Run();
+  // Send 'batch' as a single request, its requests are completed with an
+  // error if it can't be sent.
+  void Send(std::shared_ptr<Batch> batch);
+
+  const AsyncInferFn async_infer_;
+  const InferBatcherOptions options_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  // The batches being filled by key, at most one per key.
+  std::map<std::string, std::shared_ptr<Batch>> batches_;
+  // Number of batched requests sent that haven't completed.
+  size_t inflight_count_;
+  bool exiting_;
+  std::thread worker_;
+};
+
 //==============================================================================
 /// Records timestamps for different stages of request handling.
 ///
@@ -542,6 +954,11 @@ class RequestTimers {
     /// byte).
     RECV_END,
 
+    /// The start of the completion callback of an asynchronous request.
+    /// The time from REQUEST_END is spent waiting in the callback
+    /// executor.
+    CALLBACK_START,
+
     COUNT__
   };
 
@@ -615,6 +1032,8 @@ class InferRequest {
   RequestTimers& Timer() { return timer_; }
 
  protected:
+  friend class InferenceServerClient;
+
   InferenceServerClient::OnCompleteFn callback_;
   const bool verbose_;
 
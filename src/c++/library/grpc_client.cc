@@ -28,14 +28,18 @@
 #define TRITON_INFERENCE_SERVER_CLIENT_CLASS InferenceServerGrpcClient
 #include "common.h"
 
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/wire_format_lite.h>
 #include <grpcpp/grpcpp.h>
 #include <chrono>
 #include <cstdint>
+#include <deque>
 #include <fstream>
 #include <future>
 #include <iostream>
 #include <mutex>
 #include <sstream>
+#include <unordered_map>
 #include "grpc_client.h"
 
 namespace triton { namespace client {
@@ -52,6 +56,88 @@ std::map<
     grpc_channel_stub_map_;
 std::mutex grpc_channel_stub_map_mtx_;
 
+// Full name of the ModelInfer method, used for the calls made through the
+// generic stub.
+const char* kModelInferMethod = "/inference.GRPCInferenceService/ModelInfer";
+using ResponseTraits =
+    grpc::SerializationTraits<inference::ModelInferResponse>;
+
+// Set the fields of 'infer_request' that may change on each call.
+void
+SetRequestParameters(
+    const InferOptions& options, inference::ModelInferRequest* infer_request)
+{
+  infer_request->set_id(options.request_id_);
+
+  infer_request->mutable_parameters()->clear();
+  if ((options.sequence_id_ != 0) || (options.sequence_id_str_ != "")) {
+    if (options.sequence_id_ != 0) {
+      (*infer_request->mutable_parameters())["sequence_id"].set_int64_param(
+          options.sequence_id_);
+    } else {
+      (*infer_request->mutable_parameters())["sequence_id"].set_string_param(
+          options.sequence_id_str_);
+    }
+    (*infer_request->mutable_parameters())["sequence_start"].set_bool_param(
+        options.sequence_start_);
+    (*infer_request->mutable_parameters())["sequence_end"].set_bool_param(
+        options.sequence_end_);
+  }
+  if (options.priority_ != 0) {
+    (*infer_request->mutable_parameters())["priority"].set_int64_param(
+        options.priority_);
+  }
+
+  if (options.server_timeout_ != 0) {
+    (*infer_request->mutable_parameters())["timeout"].set_int64_param(
+        options.server_timeout_);
+  }
+
+  if (options.triton_enable_empty_final_response_) {
+    (*infer_request->mutable_parameters())["triton_enable_empty_final_response"]
+        .set_bool_param(true);
+  }
+}
+
+// Whether 'response' is the last response of its request. A response not
+// flagged either way is the only response of its request.
+bool
+IsFinalResponse(const inference::ModelStreamInferResponse& response)
+{
+  const auto& parameters = response.infer_response().parameters();
+  const auto it = parameters.find("triton_final_response");
+  return (it == parameters.end()) || it->second.bool_param();
+}
+
+// Return the serialized size of the 'raw_input_contents' fields holding the
+// data of the inputs that are not in shared memory.
+size_t
+RawInputContentsByteSize(const std::vector<InferInput*>& inputs)
+{
+  using google::protobuf::internal::WireFormatLite;
+  size_t byte_size = 0;
+  for (const auto input : inputs) {
+    if (!input->IsSharedMemory()) {
+      size_t content_size;
+      input->ByteSize(&content_size);
+      byte_size +=
+          WireFormatLite::TagSize(
+              inference::ModelInferRequest::kRawInputContentsFieldNumber,
+              WireFormatLite::TYPE_BYTES) +
+          WireFormatLite::LengthDelimitedSize(content_size);
+    }
+  }
+  return byte_size;
+}
+
+Error
+RequestSizeError(const size_t request_size)
+{
+  return Error(
+      "Request has byte size " + std::to_string(request_size) +
+      " which exceed gRPC's byte size limit " + std::to_string(INT_MAX) + ".");
+}
+
 std::string
 GetEnvironmentVariableOrDefault(
     const std::string& variable_name, const std::string& default_value)
@@ -75,6 +161,44 @@ ReadFile(const std::string& filename, std::string& data)
   }
 }
 
+std::shared_ptr<grpc::Channel>
+CreateChannel(
+    const std::string& url, bool use_ssl, const SslOptions& ssl_options,
+    const KeepAliveOptions& keepalive_options, const std::string& idx_key,
+    int idx)
+{
+  grpc::ChannelArguments arguments;
+  arguments.SetMaxSendMessageSize(MAX_GRPC_MESSAGE_SIZE);
+  arguments.SetMaxReceiveMessageSize(MAX_GRPC_MESSAGE_SIZE);
+  // GRPC KeepAlive: https://github.com/grpc/grpc/blob/master/doc/keepalive.md
+  arguments.SetInt(
+      GRPC_ARG_KEEPALIVE_TIME_MS, keepalive_options.keepalive_time_ms);
+  arguments.SetInt(
+      GRPC_ARG_KEEPALIVE_TIMEOUT_MS, keepalive_options.keepalive_timeout_ms);
+  arguments.SetInt(
+      GRPC_ARG_KEEPALIVE_PERMIT_WITHOUT_CALLS,
+      keepalive_options.keepalive_permit_without_calls);
+  arguments.SetInt(
+      GRPC_ARG_HTTP2_MAX_PINGS_WITHOUT_DATA,
+      keepalive_options.http2_max_pings_without_data);
+  // Channels with different arguments do not share their connection
+  arguments.SetInt(idx_key, idx);
+  std::shared_ptr<grpc::ChannelCredentials> credentials;
+  if (use_ssl) {
+    std::string root;
+    std::string key;
+    std::string cert;
+    ReadFile(ssl_options.root_certificates, root);
+    ReadFile(ssl_options.private_key, key);
+    ReadFile(ssl_options.certificate_chain, cert);
+    grpc::SslCredentialsOptions opts = {root, key, cert};
+    credentials = grpc::SslCredentials(opts);
+  } else {
+    credentials = grpc::InsecureChannelCredentials();
+  }
+  return grpc::CreateCustomChannel(url, credentials, arguments);
+}
+
 std::pair<
     std::shared_ptr<grpc::Channel>,
     std::shared_ptr<inference::GRPCInferenceService::Stub>>
@@ -98,36 +222,9 @@ GetChannelStub(
   if (channel_itr != grpc_channel_stub_map_.end()) {
     return channel_itr->second;
   } else {
-    grpc::ChannelArguments arguments;
-    arguments.SetMaxSendMessageSize(MAX_GRPC_MESSAGE_SIZE);
-    arguments.SetMaxReceiveMessageSize(MAX_GRPC_MESSAGE_SIZE);
-    // GRPC KeepAlive: https://github.com/grpc/grpc/blob/master/doc/keepalive.md
-    arguments.SetInt(
-        GRPC_ARG_KEEPALIVE_TIME_MS, keepalive_options.keepalive_time_ms);
-    arguments.SetInt(
-        GRPC_ARG_KEEPALIVE_TIMEOUT_MS, keepalive_options.keepalive_timeout_ms);
-    arguments.SetInt(
-        GRPC_ARG_KEEPALIVE_PERMIT_WITHOUT_CALLS,
-        keepalive_options.keepalive_permit_without_calls);
-    arguments.SetInt(
-        GRPC_ARG_HTTP2_MAX_PINGS_WITHOUT_DATA,
-        keepalive_options.http2_max_pings_without_data);
-    arguments.SetInt("client_channel_idx", current_idx);
-    std::shared_ptr<grpc::ChannelCredentials> credentials;
-    if (use_ssl) {
-      std::string root;
-      std::string key;
-      std::string cert;
-      ReadFile(ssl_options.root_certificates, root);
-      ReadFile(ssl_options.private_key, key);
-      ReadFile(ssl_options.certificate_chain, cert);
-      grpc::SslCredentialsOptions opts = {root, key, cert};
-      credentials = grpc::SslCredentials(opts);
-    } else {
-      credentials = grpc::InsecureChannelCredentials();
-    }
-    std::shared_ptr<grpc::Channel> channel =
-        grpc::CreateCustomChannel(url, credentials, arguments);
+    std::shared_ptr<grpc::Channel> channel = CreateChannel(
+        url, use_ssl, ssl_options, keepalive_options, "client_channel_idx",
+        current_idx);
     std::shared_ptr<inference::GRPCInferenceService::Stub> stub =
         inference::GRPCInferenceService::NewStub(channel);
     grpc_channel_stub_map_.insert(std::make_pair(
@@ -139,14 +236,180 @@ GetChannelStub(
 }
 }  // namespace
 
+//==============================================================================
+// A ChannelPool holds the channels used to reach the server and tracks the
+// number of inference RPCs in flight on each of them, so that every call can
+// be placed on the least loaded channel.
+//
+class ChannelPool {
+ public:
+  struct Channel {
+    Channel(
+        std::shared_ptr<grpc::Channel> channel,
+        std::shared_ptr<inference::GRPCInferenceService::Stub> stub)
+        : channel_(channel), stub_(stub), generic_stub_(channel),
+          inflight_count_(0)
+    {
+    }
+    std::shared_ptr<grpc::Channel> channel_;
+    std::shared_ptr<inference::GRPCInferenceService::Stub> stub_;
+    grpc::GenericStub generic_stub_;
+    std::atomic<size_t> inflight_count_;
+  };
+
+  ChannelPool() : next_channel_(0) {}
+
+  void Add(
+      std::shared_ptr<grpc::Channel> channel,
+      std::shared_ptr<inference::GRPCInferenceService::Stub> stub)
+  {
+    channels_.emplace_back(new Channel(channel, stub));
+  }
+
+  Channel& Get(size_t index) { return *channels_[index]; }
+
+  // Return the index of the channel with the fewest RPCs in flight and
+  // count a new RPC on it. The search starts from a different channel on
+  // each call so that the idle channels are used in turn.
+  size_t Acquire()
+  {
+    const size_t start = next_channel_++;
+    size_t selected = start % channels_.size();
+    size_t min_count = channels_[selected]->inflight_count_;
+    for (size_t i = 1; (i < channels_.size()) && (min_count != 0); ++i) {
+      const size_t index = (start + i) % channels_.size();
+      const size_t count = channels_[index]->inflight_count_;
+      if (count < min_count) {
+        selected = index;
+        min_count = count;
+      }
+    }
+    channels_[selected]->inflight_count_++;
+    return selected;
+  }
+
+  void Release(size_t index) { channels_[index]->inflight_count_--; }
+
+ private:
+  std::vector<std::unique_ptr<Channel>> channels_;
+  std::atomic<size_t> next_channel_;
+};
+
+namespace {
+
+// Pools of channels shared by the clients created with the same server url
+// and channel count.
+std::map<std::string, std::shared_ptr<ChannelPool>> grpc_channel_pool_map_;
+
+std::shared_ptr<ChannelPool>
+GetChannelPool(
+    const std::string& url, bool use_ssl, const SslOptions& ssl_options,
+    const KeepAliveOptions& keepalive_options,
+    const ChannelPoolOptions& channel_pool_options)
+{
+  if (channel_pool_options.channel_count == 0) {
+    // Each client gets its own pool with the single channel assigned to it
+    auto channel_stub =
+        GetChannelStub(url, use_ssl, ssl_options, keepalive_options);
+    std::shared_ptr<ChannelPool> pool = std::make_shared<ChannelPool>();
+    pool->Add(channel_stub.first, channel_stub.second);
+    return pool;
+  }
+
+  std::lock_guard<std::mutex> lock(grpc_channel_stub_map_mtx_);
+  const std::string key =
+      url + "#" + std::to_string(channel_pool_options.channel_count);
+  auto pool_itr = grpc_channel_pool_map_.find(key);
+  if (pool_itr != grpc_channel_pool_map_.end()) {
+    return pool_itr->second;
+  }
+
+  static int pool_channel_count = 0;
+  std::shared_ptr<ChannelPool> pool = std::make_shared<ChannelPool>();
+  for (size_t i = 0; i < channel_pool_options.channel_count; ++i) {
+    std::shared_ptr<grpc::Channel> channel = CreateChannel(
+        url, use_ssl, ssl_options, keepalive_options,
+        "client_channel_pool_idx", pool_channel_count++);
+    pool->Add(channel, inference::GRPCInferenceService::NewStub(channel));
+  }
+  grpc_channel_pool_map_.emplace(key, pool);
+  return pool;
+}
+
+}  // namespace
+
+//==============================================================================
+// An ArenaPool keeps protobuf arenas, each created with a preallocated
+// initial block, so that the inference messages can be allocated without
+// going through the heap allocator.
+//
+class ArenaPool : public std::enable_shared_from_this<ArenaPool> {
+ public:
+  explicit ArenaPool(const ArenaOptions& options) : options_(options) {}
+
+  // Return a message allocated on an arena of the pool. The arena is reset
+  // and returned to the pool once the last reference to the message is
+  // released.
+  template <typename MessageType>
+  std::shared_ptr<MessageType> CreateMessage()
+  {
+    PooledArena* arena = Acquire();
+    MessageType* message =
+        google::protobuf::Arena::CreateMessage<MessageType>(&arena->arena_);
+    std::shared_ptr<ArenaPool> pool = shared_from_this();
+    return std::shared_ptr<MessageType>(
+        message, [pool, arena](MessageType*) { pool->Release(arena); });
+  }
+
+ private:
+  struct PooledArena {
+    explicit PooledArena(size_t block_size)
+        : block_(new char[block_size]), arena_(block_.get(), block_size)
+    {
+    }
+    // The initial block must outlive the arena.
+    std::unique_ptr<char[]> block_;
+    google::protobuf::Arena arena_;
+  };
+
+  PooledArena* Acquire()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (arenas_.empty()) {
+      return new PooledArena(options_.initial_block_size);
+    }
+    PooledArena* arena = arenas_.back().release();
+    arenas_.pop_back();
+    return arena;
+  }
+
+  void Release(PooledArena* arena)
+  {
+    // Reset outside of the lock, the initial block is kept by the arena.
+    arena->arena_.Reset();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (arenas_.size() < options_.max_pooled_arenas) {
+      arenas_.emplace_back(arena);
+    } else {
+      delete arena;
+    }
+  }
+
+  const ArenaOptions options_;
+  std::mutex mutex_;
+  std::vector<std::unique_ptr<PooledArena>> arenas_;
+};
+
 //==============================================================================
 // An GrpcInferRequest represents an inflght inference request on gRPC.
 //
 class GrpcInferRequest : public InferRequest {
  public:
-  GrpcInferRequest(InferenceServerClient::OnCompleteFn callback = nullptr)
-      : InferRequest(callback), grpc_status_(),
-        grpc_response_(std::make_shared<inference::ModelInferResponse>())
+  GrpcInferRequest(
+      std::shared_ptr<inference::ModelInferResponse> response,
+      InferenceServerClient::OnCompleteFn callback = nullptr)
+      : InferRequest(callback), grpc_status_(), channel_index_(0),
+        grpc_response_(std::move(response))
   {
   }
 
@@ -156,11 +419,89 @@ class GrpcInferRequest : public InferRequest {
   // Variables for GRPC call
   grpc::ClientContext grpc_context_;
   grpc::Status grpc_status_;
+  // The index of the channel of the pool the request is sent on
+  size_t channel_index_;
+  // The serialized response, parsed into 'grpc_response_' once the call
+  // completes.
+  grpc::ByteBuffer grpc_response_buffer_;
   std::shared_ptr<inference::ModelInferResponse> grpc_response_;
 };
 
 //==============================================================================
 
+class GrpcPreparedRequest : public PreparedRequest {
+ public:
+  GrpcPreparedRequest(const std::string& model_name)
+      : PreparedRequest(model_name), compression_algorithm_(GRPC_COMPRESS_NONE)
+  {
+  }
+
+ private:
+  friend InferenceServerGrpcClient;
+
+  // The serialized fields of the request that are the same for every call,
+  // the model and the tensors.
+  std::string serialized_fields_;
+  Headers headers_;
+  grpc_compression_algorithm compression_algorithm_;
+};
+
+//==============================================================================
+// A GrpcStream is a bi-directional stream of the client, it owns the worker
+// thread reading the responses of the stream.
+//
+class GrpcStream {
+ public:
+  GrpcStream(
+      InferenceServerClient::OnCompleteFn callback, const bool enable_stats,
+      const size_t channel_index)
+      : callback_(callback), enable_stats_(enable_stats),
+        channel_index_(channel_index), writes_done_(false)
+  {
+  }
+
+ private:
+  friend InferenceServerGrpcClient;
+
+  // The statistics of a request in flight on the stream.
+  struct OngoingRequest {
+    OngoingRequest() : last_response_ns_(0) {}
+    RequestTimers timer_;
+    // The time the previous response of the request was received, 0 if
+    // none has been received yet.
+    uint64_t last_response_ns_;
+  };
+
+  InferenceServerClient::OnCompleteFn callback_;
+  const bool enable_stats_;
+  // The index of the channel of the pool the stream is opened on
+  const size_t channel_index_;
+  grpc::ClientContext grpc_context_;
+  std::shared_ptr<grpc::ClientReaderWriter<
+      inference::ModelInferRequest, inference::ModelStreamInferResponse>>
+      grpc_stream_;
+  std::thread worker_;
+
+  // gRPC allows a single outstanding write on a stream, so the writes of
+  // the threads sharing the stream are serialized.
+  std::mutex write_mutex_;
+  bool writes_done_;
+
+  // The requests in flight by request id, so that every response is
+  // accounted to its own request even when a request to a decoupled model
+  // receives many responses. The requests without id can't be correlated
+  // and are assumed to complete in order with a single response each. A
+  // response without id can't be told apart from an error response to a
+  // named request, so it is only matched to the oldest request without id
+  // when no named request is in flight, otherwise it isn't accounted for.
+  std::mutex ongoing_mutex_;
+  std::unordered_map<std::string, std::unique_ptr<OngoingRequest>>
+      ongoing_requests_;
+  std::deque<std::unique_ptr<OngoingRequest>> ongoing_unnamed_requests_;
+};
+
+//==============================================================================
+
 class InferResultGrpc : public InferResult {
  public:
   static Error Create(
@@ -194,10 +535,11 @@ class InferResultGrpc : public InferResult {
   InferResultGrpc(
       std::shared_ptr<inference::ModelStreamInferResponse> response);
 
-  std::map<std::string, const inference::ModelInferResponse::InferOutputTensor*>
-      output_name_to_tensor_map_;
-  std::map<std::string, std::pair<const uint8_t*, const uint32_t>>
-      output_name_to_buffer_map_;
+  // Find the index of the output named 'output_name' in the response.
+  // The outputs are already held in response order by the message so the
+  // lookup is a linear scan, which for the handful of outputs of a
+  // response is cheaper than building a map that may never be used.
+  Error FindOutput(const std::string& output_name, int* index) const;
 
   std::shared_ptr<inference::ModelInferResponse> response_;
   std::shared_ptr<inference::ModelStreamInferResponse> stream_response_;
@@ -256,16 +598,15 @@ InferResultGrpc::Shape(
     const std::string& output_name, std::vector<int64_t>* shape) const
 {
   shape->clear();
-  auto it = output_name_to_tensor_map_.find(output_name);
-  if (it != output_name_to_tensor_map_.end()) {
-    for (const auto dim : it->second->shape()) {
-      shape->push_back(dim);
-    }
-  } else {
+  int index;
+  if (!FindOutput(output_name, &index).IsOk()) {
     return Error(
         "The response does not contain shape for output name '" + output_name +
         "'");
   }
+  for (const auto dim : response_->outputs(index).shape()) {
+    shape->push_back(dim);
+  }
   return Error::Success;
 }
 
@@ -273,14 +614,13 @@ Error
 InferResultGrpc::Datatype(
     const std::string& output_name, std::string* datatype) const
 {
-  auto it = output_name_to_tensor_map_.find(output_name);
-  if (it != output_name_to_tensor_map_.end()) {
-    *datatype = it->second->datatype();
-  } else {
+  int index;
+  if (!FindOutput(output_name, &index).IsOk()) {
     return Error(
         "The response does not contain datatype for output name '" +
         output_name + "'");
   }
+  *datatype = response_->outputs(index).datatype();
   return Error::Success;
 }
 
@@ -290,14 +630,21 @@ InferResultGrpc::RawData(
     const std::string& output_name, const uint8_t** buf,
     size_t* byte_size) const
 {
-  auto it = output_name_to_buffer_map_.find(output_name);
-  if (it != output_name_to_buffer_map_.end()) {
-    *buf = it->second.first;
-    *byte_size = it->second.second;
+  int index;
+  Error err = FindOutput(output_name, &index);
+  if (!err.IsOk()) {
+    return err;
+  }
+
+  // The raw contents are absent if the output is returned in the typed
+  // contents of the tensor instead.
+  if (index < response_->raw_output_contents_size()) {
+    const std::string& contents = response_->raw_output_contents(index);
+    *buf = reinterpret_cast<const uint8_t*>(contents.data());
+    *byte_size = contents.size();
   } else {
-    return Error(
-        "The response does not contain results for output name '" +
-        output_name + "'");
+    *buf = nullptr;
+    *byte_size = 0;
   }
 
   return Error::Success;
@@ -336,8 +683,10 @@ InferResultGrpc::StringData(
       buf_offset += (sizeof(element_size) + element_size);
     }
   } else {
-    auto it = output_name_to_tensor_map_.find(output_name);
-    for (const auto& element : it->second->contents().bytes_contents()) {
+    int index;
+    FindOutput(output_name, &index);
+    for (const auto& element :
+         response_->outputs(index).contents().bytes_contents()) {
       string_result->push_back(element);
     }
   }
@@ -345,21 +694,26 @@ InferResultGrpc::StringData(
   return Error::Success;
 }
 
+Error
+InferResultGrpc::FindOutput(const std::string& output_name, int* index) const
+{
+  for (int i = 0; i < response_->outputs_size(); ++i) {
+    if (response_->outputs(i).name() == output_name) {
+      *index = i;
+      return Error::Success;
+    }
+  }
+
+  return Error(
+      "The response does not contain results for output name '" +
+      output_name + "'");
+}
+
 InferResultGrpc::InferResultGrpc(
     std::shared_ptr<inference::ModelInferResponse> response,
     Error& request_status)
     : response_(response), request_status_(request_status)
 {
-  uint32_t index = 0;
-  for (const auto& output : response_->outputs()) {
-    output_name_to_tensor_map_[output.name()] = &output;
-    const uint8_t* buf =
-        (uint8_t*)&(response_->raw_output_contents()[index][0]);
-    const uint32_t byte_size = response_->raw_output_contents()[index].size();
-    output_name_to_buffer_map_.insert(
-        std::make_pair(output.name(), std::make_pair(buf, byte_size)));
-    index++;
-  }
 }
 
 InferResultGrpc::InferResultGrpc(
@@ -370,16 +724,6 @@ InferResultGrpc::InferResultGrpc(
   response_.reset(
       stream_response->mutable_infer_response(),
       [](inference::ModelInferResponse*) {});
-  uint32_t index = 0;
-  for (const auto& output : response_->outputs()) {
-    output_name_to_tensor_map_[output.name()] = &output;
-    const uint8_t* buf =
-        (uint8_t*)&(response_->raw_output_contents()[index][0]);
-    const uint32_t byte_size = response_->raw_output_contents()[index].size();
-    output_name_to_buffer_map_.insert(
-        std::make_pair(output.name(), std::make_pair(buf, byte_size)));
-    index++;
-  }
 }
 
 //==============================================================================
@@ -388,10 +732,13 @@ Error
 InferenceServerGrpcClient::Create(
     std::unique_ptr<InferenceServerGrpcClient>* client,
     const std::string& server_url, bool verbose, bool use_ssl,
-    const SslOptions& ssl_options, const KeepAliveOptions& keepalive_options)
+    const SslOptions& ssl_options, const KeepAliveOptions& keepalive_options,
+    const AsyncOptions& async_options, const ArenaOptions& arena_options,
+    const ChannelPoolOptions& channel_pool_options)
 {
   client->reset(new InferenceServerGrpcClient(
-      server_url, verbose, use_ssl, ssl_options, keepalive_options));
+      server_url, verbose, use_ssl, ssl_options, keepalive_options,
+      async_options, arena_options, channel_pool_options));
   return Error::Success;
 }
 
@@ -883,18 +1230,85 @@ InferenceServerGrpcClient::UnregisterCudaSharedMemory(
   return err;
 }
 
+Error
+InferenceServerGrpcClient::PrepareRequest(
+    std::unique_ptr<PreparedRequest>* prepared_request,
+    const InferOptions& options, const std::vector<InferInput*>& inputs,
+    const std::vector<const InferRequestedOutput*>& outputs,
+    const Headers& headers, grpc_compression_algorithm compression_algorithm)
+{
+  std::unique_ptr<GrpcPreparedRequest> request(
+      new GrpcPreparedRequest(options.model_name_));
+  Error err = request->SetInputs(inputs);
+  if (!err.IsOk()) {
+    return err;
+  }
+
+  inference::ModelInferRequest infer_request;
+  infer_request.set_model_name(options.model_name_);
+  infer_request.set_model_version(options.model_version_);
+  PopulateTensors(
+      inputs, outputs, &infer_request, false /* copy_raw_contents */);
+  infer_request.SerializeToString(&request->serialized_fields_);
+  request->headers_ = headers;
+  request->compression_algorithm_ = compression_algorithm;
+
+  prepared_request->reset(request.release());
+  return Error::Success;
+}
+
 Error
 InferenceServerGrpcClient::Infer(
     InferResult** result, const InferOptions& options,
     const std::vector<InferInput*>& inputs,
     const std::vector<const InferRequestedOutput*>& outputs,
     const Headers& headers, grpc_compression_algorithm compression_algorithm)
+{
+  // The input buffers outlive the synchronous call so they are referenced
+  return SendSyncRequest(
+      result, options, headers, compression_algorithm,
+      [&](grpc::ByteBuffer* request_buffer, google::protobuf::Arena* arena) {
+        inference::ModelInferRequest* infer_request = AcquireInferRequest();
+        Error err = PreRunProcessing(
+            options, inputs, outputs, infer_request, request_buffer, arena,
+            true /* reference_input_data */);
+        ReleaseInferRequest(infer_request);
+        return err;
+      });
+}
+
+Error
+InferenceServerGrpcClient::Infer(
+    InferResult** result, const PreparedRequest& prepared_request,
+    const InferOptions& options)
+{
+  const GrpcPreparedRequest* grpc_prepared_request =
+      dynamic_cast<const GrpcPreparedRequest*>(&prepared_request);
+  if (grpc_prepared_request == nullptr) {
+    return Error("the request was not prepared by a gRPC client");
+  }
+
+  return SendSyncRequest(
+      result, options, grpc_prepared_request->headers_,
+      grpc_prepared_request->compression_algorithm_,
+      [&](grpc::ByteBuffer* request_buffer, google::protobuf::Arena* arena) {
+        return PreRunProcessing(
+            *grpc_prepared_request, options, request_buffer, arena);
+      });
+}
+
+Error
+InferenceServerGrpcClient::SendSyncRequest(
+    InferResult** result, const InferOptions& options, const Headers& headers,
+    grpc_compression_algorithm compression_algorithm,
+    const RequestSerializer& serialize_request)
 {
   Error err;
 
   grpc::ClientContext context;
 
-  std::shared_ptr<GrpcInferRequest> sync_request(new GrpcInferRequest());
+  std::shared_ptr<GrpcInferRequest> sync_request(
+      new GrpcInferRequest(NewInferResponse()));
 
   sync_request->Timer().Reset();
   sync_request->Timer().CaptureTimestamp(RequestTimers::Kind::REQUEST_START);
@@ -911,20 +1325,34 @@ InferenceServerGrpcClient::Infer(
   }
   context.set_compression_algorithm(compression_algorithm);
 
-  err = PreRunProcessing(options, inputs, outputs);
+  grpc::ByteBuffer request_buffer;
+  err = serialize_request(
+      &request_buffer, sync_request->grpc_response_->GetArena());
   sync_request->Timer().CaptureTimestamp(RequestTimers::Kind::SEND_END);
   if (!err.IsOk()) {
     return err;
   }
-  sync_request->grpc_response_->Clear();
-  sync_request->grpc_status_ = stub_->ModelInfer(
-      &context, infer_request_, sync_request->grpc_response_.get());
+  std::promise<grpc::Status> call_status;
+  sync_request->channel_index_ = channel_pool_->Acquire();
+  channel_pool_->Get(sync_request->channel_index_)
+      .generic_stub_.UnaryCall(
+          &context, kModelInferMethod, grpc::StubOptions(), &request_buffer,
+          &sync_request->grpc_response_buffer_,
+          [&call_status](grpc::Status status) {
+            call_status.set_value(status);
+          });
+  sync_request->grpc_status_ = call_status.get_future().get();
+  channel_pool_->Release(sync_request->channel_index_);
 
+  sync_request->Timer().CaptureTimestamp(RequestTimers::Kind::RECV_START);
+  if (sync_request->grpc_status_.ok()) {
+    sync_request->grpc_status_ = ResponseTraits::Deserialize(
+        &sync_request->grpc_response_buffer_,
+        sync_request->grpc_response_.get());
+  }
   if (!sync_request->grpc_status_.ok()) {
     err = Error(sync_request->grpc_status_.error_message());
   }
-
-  sync_request->Timer().CaptureTimestamp(RequestTimers::Kind::RECV_START);
   InferResultGrpc::Create(result, sync_request->grpc_response_, err);
   sync_request->Timer().CaptureTimestamp(RequestTimers::Kind::RECV_END);
 
@@ -950,17 +1378,72 @@ InferenceServerGrpcClient::AsyncInfer(
     const std::vector<InferInput*>& inputs,
     const std::vector<const InferRequestedOutput*>& outputs,
     const Headers& headers, grpc_compression_algorithm compression_algorithm)
+{
+  return SendAsyncRequest(
+      std::move(callback), options, headers, compression_algorithm,
+      [&](grpc::ByteBuffer* request_buffer, google::protobuf::Arena* arena) {
+        inference::ModelInferRequest* infer_request = AcquireInferRequest();
+        Error err = PreRunProcessing(
+            options, inputs, outputs, infer_request, request_buffer, arena,
+            reference_async_input_data_);
+        ReleaseInferRequest(infer_request);
+        return err;
+      });
+}
+
+Error
+InferenceServerGrpcClient::AsyncInfer(
+    OnCompleteFn callback, const PreparedRequest& prepared_request,
+    const InferOptions& options)
+{
+  const GrpcPreparedRequest* grpc_prepared_request =
+      dynamic_cast<const GrpcPreparedRequest*>(&prepared_request);
+  if (grpc_prepared_request == nullptr) {
+    return Error("the request was not prepared by a gRPC client");
+  }
+
+  return SendAsyncRequest(
+      std::move(callback), options, grpc_prepared_request->headers_,
+      grpc_prepared_request->compression_algorithm_,
+      [&](grpc::ByteBuffer* request_buffer, google::protobuf::Arena* arena) {
+        return PreRunProcessing(
+            *grpc_prepared_request, options, request_buffer, arena);
+      });
+}
+
+Error
+InferenceServerGrpcClient::CreateInferBatcher(
+    std::unique_ptr<InferBatcher>* batcher,
+    const InferBatcherOptions& batcher_options, const Headers& headers,
+    grpc_compression_algorithm compression_algorithm)
+{
+  return InferBatcher::Create(
+      batcher,
+      [this, headers, compression_algorithm](
+          OnCompleteFn callback, const InferOptions& options,
+          const std::vector<InferInput*>& inputs,
+          const std::vector<const InferRequestedOutput*>& outputs) {
+        return AsyncInfer(
+            callback, options, inputs, outputs, headers,
+            compression_algorithm);
+      },
+      batcher_options);
+}
+
+Error
+InferenceServerGrpcClient::SendAsyncRequest(
+    OnCompleteFn callback, const InferOptions& options, const Headers& headers,
+    grpc_compression_algorithm compression_algorithm,
+    const RequestSerializer& serialize_request)
 {
   if (callback == nullptr) {
     return Error(
         "Callback function must be provided along with AsyncInfer() call.");
   }
-  if (!worker_.joinable()) {
-    worker_ = std::thread(&InferenceServerGrpcClient::AsyncTransfer, this);
-  }
+  StartAsyncWorkers();
 
   GrpcInferRequest* async_request;
-  async_request = new GrpcInferRequest(std::move(callback));
+  async_request = new GrpcInferRequest(NewInferResponse(), std::move(callback));
 
   async_request->Timer().CaptureTimestamp(RequestTimers::Kind::REQUEST_START);
   async_request->Timer().CaptureTimestamp(RequestTimers::Kind::SEND_START);
@@ -975,7 +1458,9 @@ InferenceServerGrpcClient::AsyncInfer(
   }
   async_request->grpc_context_.set_compression_algorithm(compression_algorithm);
 
-  Error err = PreRunProcessing(options, inputs, outputs);
+  grpc::ByteBuffer request_buffer;
+  Error err = serialize_request(
+      &request_buffer, async_request->grpc_response_->GetArena());
   if (!err.IsOk()) {
     delete async_request;
     return err;
@@ -983,16 +1468,22 @@ InferenceServerGrpcClient::AsyncInfer(
 
   async_request->Timer().CaptureTimestamp(RequestTimers::Kind::SEND_END);
 
-  std::unique_ptr<
-      grpc::ClientAsyncResponseReader<inference::ModelInferResponse>>
-      rpc(stub_->PrepareAsyncModelInfer(
-          &async_request->grpc_context_, infer_request_,
-          &async_request_completion_queue_));
+  const size_t queue_index =
+      next_completion_queue_++ % async_request_completion_queues_.size();
+  grpc::CompletionQueue* completion_queue =
+      async_request_completion_queues_[queue_index].get();
+
+  async_request->channel_index_ = channel_pool_->Acquire();
+  std::unique_ptr<grpc::ClientAsyncResponseReader<grpc::ByteBuffer>> rpc(
+      channel_pool_->Get(async_request->channel_index_)
+          .generic_stub_.PrepareUnaryCall(
+              &async_request->grpc_context_, kModelInferMethod,
+              request_buffer, completion_queue));
 
   rpc->StartCall();
 
   rpc->Finish(
-      async_request->grpc_response_.get(), &async_request->grpc_status_,
+      &async_request->grpc_response_buffer_, &async_request->grpc_status_,
       (void*)async_request);
 
   if (verbose_) {
@@ -1027,24 +1518,27 @@ InferenceServerGrpcClient::InferMulti(
         "'outputs' must either contain 0/1 element or match size of 'inputs'");
   }
 
-  int64_t max_option_idx = options.size() - 1;
-  // value of '-1' means no output is specified
-  int64_t max_output_idx = outputs.size() - 1;
-  static std::vector<const InferRequestedOutput*> empty_outputs{};
-  for (int64_t i = 0; i < (int64_t)inputs.size(); ++i) {
-    const auto& request_options = options[std::min(max_option_idx, i)];
-    const auto& request_output = (max_output_idx == -1)
-                                     ? empty_outputs
-                                     : outputs[std::min(max_output_idx, i)];
-    results->emplace_back();
-    err = Infer(
-        &results->back(), request_options, inputs[i], request_output, headers,
-        compression_algorithm);
-    if (!err.IsOk()) {
-      return err;
+  if (inputs.empty()) {
+    return Error::Success;
+  }
+
+  // Send all the requests at once and wait for the last of them to complete
+  std::promise<std::vector<InferResult*>> multi_results;
+  err = AsyncInferMulti(
+      [&multi_results](std::vector<InferResult*> async_results) {
+        multi_results.set_value(std::move(async_results));
+      },
+      options, inputs, outputs, headers, compression_algorithm);
+  if (!err.IsOk()) {
+    return err;
+  }
+  for (auto result : multi_results.get_future().get()) {
+    results->emplace_back(result);
+    if (err.IsOk()) {
+      err = result->RequestStatus();
     }
   }
-  return Error::Success;
+  return err;
 }
 
 Error
@@ -1069,9 +1563,6 @@ InferenceServerGrpcClient::AsyncInferMulti(
         "Callback function must be provided along with AsyncInferMulti() "
         "call.");
   }
-  if (!worker_.joinable()) {
-    worker_ = std::thread(&InferenceServerGrpcClient::AsyncTransfer, this);
-  }
 
   int64_t max_option_idx = options.size() - 1;
   // value of '-1' means no output is specified
@@ -1121,38 +1612,82 @@ InferenceServerGrpcClient::StartStream(
     OnCompleteFn callback, bool enable_stats, uint32_t stream_timeout,
     const Headers& headers, grpc_compression_algorithm compression_algorithm)
 {
-  if (stream_worker_.joinable()) {
-    return Error(
-        "cannot start another stream with one already running. "
-        "'InferenceServerClient' supports only a single active "
-        "stream at a given time.");
+  // Reserve the id until the stream is registered
+  {
+    std::lock_guard<std::mutex> lock(streams_mutex_);
+    if (default_stream_opening_ ||
+        (streams_.find(kDefaultStreamId) != streams_.end())) {
+      return Error(
+          "cannot start another stream with one already running. Use "
+          "StartStream() with a stream id to run several streams at a "
+          "time.");
+    }
+    default_stream_opening_ = true;
   }
 
+  Error err = OpenStream(
+      kDefaultStreamId, callback, enable_stats, stream_timeout, headers,
+      compression_algorithm);
+
+  {
+    std::lock_guard<std::mutex> lock(streams_mutex_);
+    default_stream_opening_ = false;
+  }
+  return err;
+}
+
+Error
+InferenceServerGrpcClient::StartStream(
+    size_t* stream_id, OnCompleteFn callback, bool enable_stats,
+    uint32_t stream_timeout, const Headers& headers,
+    grpc_compression_algorithm compression_algorithm)
+{
+  *stream_id = next_stream_id_++;
+  return OpenStream(
+      *stream_id, callback, enable_stats, stream_timeout, headers,
+      compression_algorithm);
+}
+
+Error
+InferenceServerGrpcClient::OpenStream(
+    const size_t stream_id, OnCompleteFn callback, bool enable_stats,
+    uint32_t stream_timeout, const Headers& headers,
+    grpc_compression_algorithm compression_algorithm)
+{
   if (callback == nullptr) {
     return Error(
         "Callback function must be provided along with StartStream() call.");
   }
 
-  stream_callback_ = callback;
-  enable_stream_stats_ = enable_stats;
+  // Open the streams on the least busy channels so that the streams of a
+  // client don't all share a single connection.
+  std::shared_ptr<GrpcStream> stream = std::make_shared<GrpcStream>(
+      callback, enable_stats, channel_pool_->Acquire());
 
   for (const auto& it : headers) {
-    grpc_context_.AddMetadata(it.first, it.second);
+    stream->grpc_context_.AddMetadata(it.first, it.second);
   }
 
   if (stream_timeout != 0) {
     auto deadline = std::chrono::system_clock::now() +
                     std::chrono::microseconds(stream_timeout);
-    grpc_context_.set_deadline(deadline);
+    stream->grpc_context_.set_deadline(deadline);
   }
-  grpc_context_.set_compression_algorithm(compression_algorithm);
+  stream->grpc_context_.set_compression_algorithm(compression_algorithm);
 
-  grpc_stream_ = stub_->ModelStreamInfer(&grpc_context_);
-  stream_worker_ =
-      std::thread(&InferenceServerGrpcClient::AsyncStreamTransfer, this);
+  stream->grpc_stream_ =
+      channel_pool_->Get(stream->channel_index_)
+          .stub_->ModelStreamInfer(&stream->grpc_context_);
+  stream->worker_ = std::thread(
+      &InferenceServerGrpcClient::AsyncStreamTransfer, this, stream.get());
+
+  {
+    std::lock_guard<std::mutex> lock(streams_mutex_);
+    streams_.emplace(stream_id, stream);
+  }
 
   if (verbose_) {
-    std::cout << "Started stream..." << std::endl;
+    std::cout << "Started stream " << stream_id << "..." << std::endl;
   }
 
   return Error::Success;
@@ -1161,13 +1696,40 @@ InferenceServerGrpcClient::StartStream(
 Error
 InferenceServerGrpcClient::StopStream()
 {
-  if (stream_worker_.joinable()) {
-    grpc_stream_->WritesDone();
-    // The reader thread will drain the stream properly
-    stream_worker_.join();
-    if (verbose_) {
-      std::cout << "Stopped stream..." << std::endl;
+  {
+    std::lock_guard<std::mutex> lock(streams_mutex_);
+    if (streams_.find(kDefaultStreamId) == streams_.end()) {
+      return Error::Success;
+    }
+  }
+
+  return StopStream(kDefaultStreamId);
+}
+
+Error
+InferenceServerGrpcClient::StopStream(const size_t stream_id)
+{
+  std::shared_ptr<GrpcStream> stream;
+  {
+    std::lock_guard<std::mutex> lock(streams_mutex_);
+    auto it = streams_.find(stream_id);
+    if (it == streams_.end()) {
+      return Error("stream " + std::to_string(stream_id) + " is not running");
     }
+    stream = std::move(it->second);
+    streams_.erase(it);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(stream->write_mutex_);
+    stream->grpc_stream_->WritesDone();
+    stream->writes_done_ = true;
+  }
+  // The reader thread will drain the stream properly
+  stream->worker_.join();
+  channel_pool_->Release(stream->channel_index_);
+  if (verbose_) {
+    std::cout << "Stopped stream " << stream_id << "..." << std::endl;
   }
 
   return Error::Success;
@@ -1178,27 +1740,63 @@ InferenceServerGrpcClient::AsyncStreamInfer(
     const InferOptions& options, const std::vector<InferInput*>& inputs,
     const std::vector<const InferRequestedOutput*>& outputs)
 {
-  std::unique_ptr<RequestTimers> timer;
-  if (enable_stream_stats_) {
-    timer.reset(new RequestTimers());
-    timer->CaptureTimestamp(RequestTimers::Kind::REQUEST_START);
-    timer->CaptureTimestamp(RequestTimers::Kind::SEND_START);
+  return AsyncStreamInfer(kDefaultStreamId, options, inputs, outputs);
+}
+
+Error
+InferenceServerGrpcClient::AsyncStreamInfer(
+    const size_t stream_id, const InferOptions& options,
+    const std::vector<InferInput*>& inputs,
+    const std::vector<const InferRequestedOutput*>& outputs)
+{
+  std::shared_ptr<GrpcStream> stream;
+  {
+    std::lock_guard<std::mutex> lock(streams_mutex_);
+    auto it = streams_.find(stream_id);
+    if (it == streams_.end()) {
+      return Error("stream " + std::to_string(stream_id) + " is not running");
+    }
+    stream = it->second;
   }
 
-  Error err = PreRunProcessing(options, inputs, outputs);
+  std::unique_ptr<GrpcStream::OngoingRequest> ongoing_request;
+  if (stream->enable_stats_) {
+    ongoing_request.reset(new GrpcStream::OngoingRequest());
+    ongoing_request->timer_.CaptureTimestamp(
+        RequestTimers::Kind::REQUEST_START);
+    ongoing_request->timer_.CaptureTimestamp(RequestTimers::Kind::SEND_START);
+  }
+
+  inference::ModelInferRequest* infer_request = AcquireInferRequest();
+  Error err = PreRunProcessing(options, inputs, outputs, infer_request);
   if (!err.IsOk()) {
+    ReleaseInferRequest(infer_request);
     return err;
   }
 
-  if (enable_stream_stats_) {
-    timer->CaptureTimestamp(RequestTimers::Kind::SEND_END);
+  if (stream->enable_stats_) {
+    ongoing_request->timer_.CaptureTimestamp(RequestTimers::Kind::SEND_END);
+    // The request must be tracked before it is written as its response may
+    // arrive before Write() returns. The statistics of a request are not
+    // recorded if another request with the same id is in flight.
+    std::lock_guard<std::mutex> lock(stream->ongoing_mutex_);
+    if (options.request_id_.empty()) {
+      stream->ongoing_unnamed_requests_.emplace_back(
+          std::move(ongoing_request));
+    } else {
+      stream->ongoing_requests_.emplace(
+          options.request_id_, std::move(ongoing_request));
+    }
   }
 
-  if (enable_stream_stats_) {
-    std::lock_guard<std::mutex> lock(stream_mutex_);
-    ongoing_stream_request_timers_.push(std::move(timer));
+  bool ok = false;
+  {
+    std::lock_guard<std::mutex> lock(stream->write_mutex_);
+    if (!stream->writes_done_) {
+      ok = stream->grpc_stream_->Write(*infer_request);
+    }
   }
-  bool ok = grpc_stream_->Write(infer_request_);
+  ReleaseInferRequest(infer_request);
 
   if (ok) {
     if (verbose_) {
@@ -1206,7 +1804,7 @@ InferenceServerGrpcClient::AsyncStreamInfer(
       if (options.request_id_.size() != 0) {
         std::cout << " '" << options.request_id_ << "'";
       }
-      std::cout << " to the stream" << std::endl;
+      std::cout << " to stream " << stream_id << std::endl;
     }
     return Error::Success;
   } else {
@@ -1217,45 +1815,88 @@ InferenceServerGrpcClient::AsyncStreamInfer(
 Error
 InferenceServerGrpcClient::PreRunProcessing(
     const InferOptions& options, const std::vector<InferInput*>& inputs,
-    const std::vector<const InferRequestedOutput*>& outputs)
+    const std::vector<const InferRequestedOutput*>& outputs,
+    inference::ModelInferRequest* infer_request,
+    grpc::ByteBuffer* request_buffer, google::protobuf::Arena* arena,
+    const bool reference_input_data)
 {
   // Populate the request protobuf
-  infer_request_.set_model_name(options.model_name_);
-  infer_request_.set_model_version(options.model_version_);
-  infer_request_.set_id(options.request_id_);
+  infer_request->set_model_name(options.model_name_);
+  infer_request->set_model_version(options.model_version_);
+  SetRequestParameters(options, infer_request);
+  PopulateTensors(
+      inputs, outputs, infer_request,
+      (request_buffer == nullptr) /* copy_raw_contents */);
 
-  infer_request_.mutable_parameters()->clear();
-  if ((options.sequence_id_ != 0) || (options.sequence_id_str_ != "")) {
-    if (options.sequence_id_ != 0) {
-      (*infer_request_.mutable_parameters())["sequence_id"].set_int64_param(
-          options.sequence_id_);
-    } else {
-      (*infer_request_.mutable_parameters())["sequence_id"].set_string_param(
-          options.sequence_id_str_);
-    }
-    (*infer_request_.mutable_parameters())["sequence_start"].set_bool_param(
-        options.sequence_start_);
-    (*infer_request_.mutable_parameters())["sequence_end"].set_bool_param(
-        options.sequence_end_);
+  size_t request_size = infer_request->ByteSizeLong();
+  if (request_buffer != nullptr) {
+    // Account for the raw input contents that are referenced instead of
+    // being copied into 'infer_request'.
+    request_size += RawInputContentsByteSize(inputs);
   }
-  if (options.priority_ != 0) {
-    (*infer_request_.mutable_parameters())["priority"].set_int64_param(
-        options.priority_);
+  if (request_size > INT_MAX) {
+    infer_request->Clear();
+    return RequestSizeError(request_size);
   }
 
-  if (options.server_timeout_ != 0) {
-    (*infer_request_.mutable_parameters())["timeout"].set_int64_param(
-        options.server_timeout_);
+  if (request_buffer != nullptr) {
+    SerializeInferRequest(
+        *infer_request, nullptr /* prepared_fields */, inputs, request_buffer,
+        arena, reference_input_data);
+  }
+
+  return Error::Success;
+}
+
+Error
+InferenceServerGrpcClient::PreRunProcessing(
+    const GrpcPreparedRequest& prepared_request, const InferOptions& options,
+    grpc::ByteBuffer* request_buffer, google::protobuf::Arena* arena)
+{
+  Error err = prepared_request.CheckInputByteSizes();
+  if (!err.IsOk()) {
+    return err;
   }
 
+  // Only the per-call fields are set, the others are already serialized
+  inference::ModelInferRequest* infer_request = AcquireInferRequest();
+  infer_request->Clear();
+  SetRequestParameters(options, infer_request);
+
+  const size_t request_size =
+      infer_request->ByteSizeLong() +
+      prepared_request.serialized_fields_.size() +
+      RawInputContentsByteSize(prepared_request.inputs_);
+  if (request_size > INT_MAX) {
+    ReleaseInferRequest(infer_request);
+    return RequestSizeError(request_size);
+  }
+
+  // The input data of a prepared request is required to remain valid until
+  // the request completes, so it is always referenced.
+  SerializeInferRequest(
+      *infer_request, &prepared_request.serialized_fields_,
+      prepared_request.inputs_, request_buffer, arena,
+      true /* reference_input_data */);
+  ReleaseInferRequest(infer_request);
+
+  return Error::Success;
+}
+
+void
+InferenceServerGrpcClient::PopulateTensors(
+    const std::vector<InferInput*>& inputs,
+    const std::vector<const InferRequestedOutput*>& outputs,
+    inference::ModelInferRequest* infer_request, const bool copy_raw_contents)
+{
   int index = 0;
-  infer_request_.mutable_raw_input_contents()->Clear();
+  infer_request->mutable_raw_input_contents()->Clear();
   for (const auto input : inputs) {
     // Add new InferInputTensor submessages only if required, otherwise
     // reuse the submessages already available.
-    auto grpc_input = (infer_request_.inputs().size() <= index)
-                          ? infer_request_.add_inputs()
-                          : infer_request_.mutable_inputs()->Mutable(index);
+    auto grpc_input = (infer_request->inputs().size() <= index)
+                          ? infer_request->add_inputs()
+                          : infer_request->mutable_inputs()->Mutable(index);
 
     if (input->IsSharedMemory()) {
       // The input contents must be cleared when using shared memory.
@@ -1285,9 +1926,9 @@ InferenceServerGrpcClient::PreRunProcessing(
         (*grpc_input->mutable_parameters())["shared_memory_offset"]
             .set_int64_param(offset);
       }
-    } else {
+    } else if (copy_raw_contents) {
       bool end_of_input = false;
-      std::string* raw_contents = infer_request_.add_raw_input_contents();
+      std::string* raw_contents = infer_request->add_raw_input_contents();
       size_t content_size;
       input->ByteSize(&content_size);
       raw_contents->reserve(content_size);
@@ -1306,17 +1947,17 @@ InferenceServerGrpcClient::PreRunProcessing(
 
   // Remove extra InferInputTensor submessages, that are not required for
   // this request.
-  while (index < infer_request_.inputs().size()) {
-    infer_request_.mutable_inputs()->RemoveLast();
+  while (index < infer_request->inputs().size()) {
+    infer_request->mutable_inputs()->RemoveLast();
   }
 
   index = 0;
   for (const auto routput : outputs) {
     // Add new InferRequestedOutputTensor submessage only if required, otherwise
     // reuse the submessages already available.
-    auto grpc_output = (infer_request_.outputs().size() <= index)
-                           ? infer_request_.add_outputs()
-                           : infer_request_.mutable_outputs()->Mutable(index);
+    auto grpc_output = (infer_request->outputs().size() <= index)
+                           ? infer_request->add_outputs()
+                           : infer_request->mutable_outputs()->Mutable(index);
     grpc_output->Clear();
     grpc_output->set_name(routput->Name());
     size_t class_count = routput->ClassificationCount();
@@ -1343,31 +1984,150 @@ InferenceServerGrpcClient::PreRunProcessing(
 
   // Remove extra InferRequestedOutputTensor submessages, that are not required
   // for this request.
-  while (index < infer_request_.outputs().size()) {
-    infer_request_.mutable_outputs()->RemoveLast();
+  while (index < infer_request->outputs().size()) {
+    infer_request->mutable_outputs()->RemoveLast();
   }
+}
 
-  if (infer_request_.ByteSizeLong() > INT_MAX) {
-    size_t request_size = infer_request_.ByteSizeLong();
-    infer_request_.Clear();
-    return Error(
-        "Request has byte size " + std::to_string(request_size) +
-        " which exceed gRPC's byte size limit " + std::to_string(INT_MAX) +
-        ".");
+inference::ModelInferRequest*
+InferenceServerGrpcClient::AcquireInferRequest()
+{
+  std::lock_guard<std::mutex> lock(infer_request_pool_mutex_);
+  if (infer_request_pool_.empty()) {
+    return new inference::ModelInferRequest();
+  }
+  inference::ModelInferRequest* infer_request =
+      infer_request_pool_.back().release();
+  infer_request_pool_.pop_back();
+  return infer_request;
+}
+
+void
+InferenceServerGrpcClient::ReleaseInferRequest(
+    inference::ModelInferRequest* infer_request)
+{
+  std::lock_guard<std::mutex> lock(infer_request_pool_mutex_);
+  infer_request_pool_.emplace_back(infer_request);
+}
+
+void
+InferenceServerGrpcClient::SerializeInferRequest(
+    const inference::ModelInferRequest& infer_request,
+    const std::string* prepared_fields, const std::vector<InferInput*>& inputs,
+    grpc::ByteBuffer* request_buffer, google::protobuf::Arena* arena,
+    const bool reference_input_data)
+{
+  using google::protobuf::internal::WireFormatLite;
+  using google::protobuf::io::CodedOutputStream;
+
+  // Protobuf parsers accept the fields of a message in any order, so the
+  // request is sent as the serialized 'infer_request' (which has no raw
+  // input contents) followed by one 'raw_input_contents' field per input.
+  // The field header is small and is copied, the input data is referenced
+  // by static slices if 'reference_input_data' is true so it is handed to
+  // gRPC without being copied, or copied into the slices otherwise. If an
+  // arena is provided, the serialized parts are placed on it and referenced
+  // as well, the arena is not reset before the call completes. The fields of
+  // a prepared request are referenced in the same way.
+  std::vector<grpc::Slice> slices;
+  if (arena != nullptr) {
+    // Sizes are cached by the ByteSizeLong() call in PreRunProcessing().
+    const size_t header_size = infer_request.GetCachedSize();
+    uint8_t* header =
+        google::protobuf::Arena::CreateArray<uint8_t>(arena, header_size);
+    infer_request.SerializeWithCachedSizesToArray(header);
+    slices.emplace_back(header, header_size, grpc::Slice::STATIC_SLICE);
+  } else {
+    slices.emplace_back(infer_request.SerializeAsString());
+  }
+  if (prepared_fields != nullptr) {
+    slices.emplace_back(
+        prepared_fields->data(), prepared_fields->size(),
+        grpc::Slice::STATIC_SLICE);
   }
+  for (const auto input : inputs) {
+    if (input->IsSharedMemory()) {
+      continue;
+    }
+    input->PrepareForRequest();
+    size_t content_size;
+    input->ByteSize(&content_size);
+    // Large enough for the tag and the varint encoded length
+    constexpr size_t kFieldHeaderCapacity = 16;
+    uint8_t local_field_header[kFieldHeaderCapacity];
+    uint8_t* field_header = (arena != nullptr)
+                                ? google::protobuf::Arena::CreateArray<uint8_t>(
+                                      arena, kFieldHeaderCapacity)
+                                : local_field_header;
+    uint8_t* header_end = WireFormatLite::WriteTagToArray(
+        inference::ModelInferRequest::kRawInputContentsFieldNumber,
+        WireFormatLite::WIRETYPE_LENGTH_DELIMITED, field_header);
+    header_end = CodedOutputStream::WriteVarint32ToArray(
+        static_cast<uint32_t>(content_size), header_end);
+    if (arena != nullptr) {
+      slices.emplace_back(
+          field_header, header_end - field_header, grpc::Slice::STATIC_SLICE);
+    } else {
+      slices.emplace_back(field_header, header_end - field_header);
+    }
 
-  return Error::Success;
+    bool end_of_input = false;
+    while (!end_of_input) {
+      const uint8_t* buf;
+      size_t buf_size;
+      input->GetNext(&buf, &buf_size, &end_of_input);
+      if ((buf != nullptr) && (buf_size != 0)) {
+        if (reference_input_data) {
+          slices.emplace_back(buf, buf_size, grpc::Slice::STATIC_SLICE);
+        } else {
+          slices.emplace_back(buf, buf_size);
+        }
+      }
+    }
+  }
+  *request_buffer = grpc::ByteBuffer(slices.data(), slices.size());
+}
+
+std::shared_ptr<inference::ModelInferResponse>
+InferenceServerGrpcClient::NewInferResponse()
+{
+  if (arena_pool_ != nullptr) {
+    return arena_pool_->CreateMessage<inference::ModelInferResponse>();
+  }
+  return std::make_shared<inference::ModelInferResponse>();
+}
+
+std::shared_ptr<inference::ModelStreamInferResponse>
+InferenceServerGrpcClient::NewStreamInferResponse()
+{
+  if (arena_pool_ != nullptr) {
+    return arena_pool_->CreateMessage<inference::ModelStreamInferResponse>();
+  }
+  return std::make_shared<inference::ModelStreamInferResponse>();
 }
 
 void
-InferenceServerGrpcClient::AsyncTransfer()
+InferenceServerGrpcClient::StartAsyncWorkers()
+{
+  // threads are not started until the first asynchronous request
+  std::call_once(async_workers_started_, [this] {
+    for (auto& completion_queue : async_request_completion_queues_) {
+      async_workers_.emplace_back(
+          &InferenceServerGrpcClient::AsyncTransfer, this,
+          completion_queue.get());
+    }
+  });
+}
+
+void
+InferenceServerGrpcClient::AsyncTransfer(
+    grpc::CompletionQueue* completion_queue)
 {
   while (!exiting_) {
     // GRPC async APIs are thread-safe https://github.com/grpc/grpc/issues/4486
     GrpcInferRequest* raw_async_request;
     bool ok = true;
-    bool status =
-        async_request_completion_queue_.Next((void**)(&raw_async_request), &ok);
+    bool status = completion_queue->Next((void**)(&raw_async_request), &ok);
     std::shared_ptr<GrpcInferRequest> async_request;
     if (!ok) {
       fprintf(stderr, "Unexpected not ok on client side.\n");
@@ -1380,12 +2140,21 @@ InferenceServerGrpcClient::AsyncTransfer()
       fprintf(stderr, "Unexpected null tag received at client.\n");
     } else {
       async_request.reset(raw_async_request);
+      channel_pool_->Release(async_request->channel_index_);
       InferResult* async_result;
       Error err;
       if (!async_request->grpc_status_.ok()) {
         err = Error(async_request->grpc_status_.error_message());
       }
       async_request->Timer().CaptureTimestamp(RequestTimers::Kind::RECV_START);
+      if (async_request->grpc_status_.ok()) {
+        async_request->grpc_status_ = ResponseTraits::Deserialize(
+            &async_request->grpc_response_buffer_,
+            async_request->grpc_response_.get());
+        if (!async_request->grpc_status_.ok()) {
+          err = Error(async_request->grpc_status_.error_message());
+        }
+      }
       InferResultGrpc::Create(
           &async_result, async_request->grpc_response_, err);
       async_request->Timer().CaptureTimestamp(RequestTimers::Kind::RECV_END);
@@ -1400,93 +2169,153 @@ InferenceServerGrpcClient::AsyncTransfer()
                     << std::endl;
         }
       }
-      async_request->callback_(async_result);
+      ExecuteCallback(async_request, async_result);
     }
   }
 }
 
 void
-InferenceServerGrpcClient::AsyncStreamTransfer()
+InferenceServerGrpcClient::AsyncStreamTransfer(GrpcStream* stream)
 {
   std::shared_ptr<inference::ModelStreamInferResponse> response =
-      std::make_shared<inference::ModelStreamInferResponse>();
+      NewStreamInferResponse();
   // End loop if Read() returns false
   // (stream ended and all responses are drained)
-  while (grpc_stream_->Read(response.get())) {
+  while (stream->grpc_stream_->Read(response.get())) {
     if (exiting_) {
       continue;
     }
 
-    std::unique_ptr<RequestTimers> timer;
-    if (enable_stream_stats_) {
-      std::lock_guard<std::mutex> lock(stream_mutex_);
-      if (!ongoing_stream_request_timers_.empty()) {
-        timer = std::move(ongoing_stream_request_timers_.front());
-        ongoing_stream_request_timers_.pop();
+    // Take the request the response belongs to, it is put back if more
+    // responses are expected for it.
+    const bool is_final = IsFinalResponse(*response);
+    const std::string& request_id = response->infer_response().id();
+    std::unique_ptr<GrpcStream::OngoingRequest> ongoing_request;
+    if (stream->enable_stats_) {
+      std::lock_guard<std::mutex> lock(stream->ongoing_mutex_);
+      if (!request_id.empty()) {
+        auto it = stream->ongoing_requests_.find(request_id);
+        if (it != stream->ongoing_requests_.end()) {
+          ongoing_request = std::move(it->second);
+          stream->ongoing_requests_.erase(it);
+        }
+      } else if (
+          stream->ongoing_requests_.empty() &&
+          !stream->ongoing_unnamed_requests_.empty()) {
+        ongoing_request = std::move(stream->ongoing_unnamed_requests_.front());
+        stream->ongoing_unnamed_requests_.pop_front();
       }
     }
 
     InferResult* stream_result;
-    // FIXME, DLIS-1263 there is no 1:1 mapping between
-    // requests and response for decoupled streaming case
-    // hence, this method will record incorrect statistics
-    // for decoupled case.
-    if (timer.get() != nullptr) {
-      timer->CaptureTimestamp(RequestTimers::Kind::RECV_START);
+    if (ongoing_request != nullptr) {
+      RequestTimers& timer = ongoing_request->timer_;
+      if (ongoing_request->last_response_ns_ == 0) {
+        ongoing_request->last_response_ns_ =
+            timer.CaptureTimestamp(RequestTimers::Kind::RECV_START);
+        UpdateResponseStat(
+            timer.Duration(
+                RequestTimers::Kind::REQUEST_START,
+                RequestTimers::Kind::RECV_START),
+            true /* first_response */);
+      } else {
+        const uint64_t response_ns =
+            timer.CaptureTimestamp(RequestTimers::Kind::RECV_END);
+        UpdateResponseStat(
+            response_ns - ongoing_request->last_response_ns_,
+            false /* first_response */);
+        ongoing_request->last_response_ns_ = response_ns;
+      }
     }
     InferResultGrpc::Create(&stream_result, response);
-    if (timer.get() != nullptr) {
-      timer->CaptureTimestamp(RequestTimers::Kind::RECV_END);
-      timer->CaptureTimestamp(RequestTimers::Kind::REQUEST_END);
-      Error err = UpdateInferStat(*timer);
-      if (!err.IsOk()) {
-        std::cerr << "Failed to update context stat: " << err << std::endl;
+    if (ongoing_request != nullptr) {
+      if (is_final || request_id.empty()) {
+        RequestTimers& timer = ongoing_request->timer_;
+        timer.CaptureTimestamp(RequestTimers::Kind::RECV_END);
+        timer.CaptureTimestamp(RequestTimers::Kind::REQUEST_END);
+        Error err = UpdateInferStat(timer);
+        if (!err.IsOk()) {
+          std::cerr << "Failed to update context stat: " << err << std::endl;
+        }
+      } else {
+        std::lock_guard<std::mutex> lock(stream->ongoing_mutex_);
+        stream->ongoing_requests_.emplace(
+            request_id, std::move(ongoing_request));
       }
     }
     if (verbose_) {
       std::cout << response->DebugString() << std::endl;
     }
-    stream_callback_(stream_result);
-    response = std::make_shared<inference::ModelStreamInferResponse>();
+    stream->callback_(stream_result);
+    response = NewStreamInferResponse();
   }
-  grpc_stream_->Finish();
+  stream->grpc_stream_->Finish();
 }
 
+constexpr size_t InferenceServerGrpcClient::kDefaultStreamId;
 
 InferenceServerGrpcClient::InferenceServerGrpcClient(
     const std::string& url, bool verbose, bool use_ssl,
-    const SslOptions& ssl_options, const KeepAliveOptions& keepalive_options)
-    : InferenceServerClient(verbose)
+    const SslOptions& ssl_options, const KeepAliveOptions& keepalive_options,
+    const AsyncOptions& async_options, const ArenaOptions& arena_options,
+    const ChannelPoolOptions& channel_pool_options)
+    : InferenceServerClient(verbose), next_completion_queue_(0),
+      reference_async_input_data_(async_options.reference_input_data),
+      default_stream_opening_(false), next_stream_id_(kDefaultStreamId + 1)
 {
-  auto channel_stub =
-      GetChannelStub(url, use_ssl, ssl_options, keepalive_options);
-  stub_ = channel_stub.second;
+  channel_pool_ = GetChannelPool(
+      url, use_ssl, ssl_options, keepalive_options, channel_pool_options);
+  // The RPCs other than inference use the first channel of the pool
+  stub_ = channel_pool_->Get(0).stub_;
+  if (arena_options.use_arena) {
+    arena_pool_ = std::make_shared<ArenaPool>(arena_options);
+  }
+
+  const size_t completion_queue_count =
+      (std::max)(async_options.completion_queue_count, size_t(1));
+  for (size_t i = 0; i < completion_queue_count; ++i) {
+    async_request_completion_queues_.emplace_back(new grpc::CompletionQueue());
+  }
 }
 
 InferenceServerGrpcClient::~InferenceServerGrpcClient()
 {
+  WaitForPendingCallbacks();
   exiting_ = true;
-  // Close complete queue and wait for the worker thread to return
-  async_request_completion_queue_.Shutdown();
-
-  // thread not joinable if AsyncInfer() is not called
-  // (it is default constructed thread before the first AsyncInfer() call)
-  if (worker_.joinable()) {
-    worker_.join();
+  // Close complete queues and wait for the worker threads to return
+  for (auto& completion_queue : async_request_completion_queues_) {
+    completion_queue->Shutdown();
+  }
+
+  // threads are not started if AsyncInfer() is not called
+  for (auto& worker : async_workers_) {
+    worker.join();
+  }
+
+  for (auto& completion_queue : async_request_completion_queues_) {
+    bool has_next = true;
+    GrpcInferRequest* async_request;
+    bool ok;
+    do {
+      has_next = completion_queue->Next((void**)&async_request, &ok);
+      if (has_next && async_request != nullptr) {
+        // The pool may be shared with other clients
+        channel_pool_->Release(async_request->channel_index_);
+        delete async_request;
+      }
+    } while (has_next);
   }
 
-  bool has_next = true;
-  GrpcInferRequest* async_request;
-  bool ok;
-  do {
-    has_next =
-        async_request_completion_queue_.Next((void**)&async_request, &ok);
-    if (has_next && async_request != nullptr) {
-      delete async_request;
+  std::vector<size_t> stream_ids;
+  {
+    std::lock_guard<std::mutex> lock(streams_mutex_);
+    for (const auto& stream : streams_) {
+      stream_ids.push_back(stream.first);
     }
-  } while (has_next);
-
-  StopStream();
+  }
+  for (const auto stream_id : stream_ids) {
+    StopStream(stream_id);
+  }
 }
 
 //==============================================================================
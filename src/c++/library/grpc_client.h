@@ -27,7 +27,10 @@
 
 /// \file
 
-#include <queue>
+#include <grpcpp/generic/generic_stub.h>
+#include <atomic>
+#include <functional>
+#include <mutex>
 #include "common.h"
 #include "grpc_service.grpc.pb.h"
 #include "ipc.h"
@@ -80,12 +83,74 @@ struct KeepAliveOptions {
   int http2_max_pings_without_data;
 };
 
+// The options for the engine performing the asynchronous requests.
+struct AsyncOptions {
+  explicit AsyncOptions()
+      : completion_queue_count(1), reference_input_data(false)
+  {
+  }
+  // The number of completion queues used for the asynchronous requests,
+  // each of them is drained by a separate thread that also runs the
+  // callbacks of its requests. The requests are spread over the queues in
+  // turn. With more than one queue the callbacks may be invoked concurrently
+  // from different threads. Default value is 1.
+  size_t completion_queue_count;
+  // If true, the raw input data of the requests sent by AsyncInfer,
+  // AsyncInferMulti and the InferBatcher objects of the client is handed to
+  // gRPC directly from the buffers registered with InferInput::AppendRaw
+  // instead of being copied. These buffers must then not be modified or
+  // released until the callback of the request is invoked. If false, the
+  // data is copied before the call returns and the buffers can be reused
+  // right away. Default value is false.
+  bool reference_input_data;
+};
+
+// The options for allocating the inference messages on protobuf arenas.
+struct ArenaOptions {
+  explicit ArenaOptions()
+      : use_arena(false), initial_block_size(64 * 1024), max_pooled_arenas(64)
+  {
+  }
+  // If true, the response of each inference request and the serialized
+  // request share a google::protobuf::Arena taken from a pool owned by the
+  // client. The arena is reset and returned to the pool once the InferResult
+  // of the request is destroyed. The responses of the stream are allocated
+  // the same way. Default value is false.
+  bool use_arena;
+  // The size, in bytes, of the block each arena is created with. This block
+  // is kept when the arena is recycled so messages that fit in it are
+  // allocated without going through the heap allocator.
+  size_t initial_block_size;
+  // The maximum number of idle arenas kept in the pool, additional arenas
+  // are released once they are no longer used.
+  size_t max_pooled_arenas;
+};
+
+// The options for the channels used to reach the server.
+struct ChannelPoolOptions {
+  explicit ChannelPoolOptions() : channel_count(0) {}
+  // The number of channels, each with its own connection, in the pool
+  // shared by all the clients created with the same server URL and channel
+  // count. Each inference request is sent on the channel of the pool with
+  // the fewest requests in flight. If 0, the client is assigned a single
+  // channel shared by up to TRITON_CLIENT_GRPC_CHANNEL_MAX_SHARE_COUNT
+  // clients. Default value is 0.
+  size_t channel_count;
+};
+
+class ArenaPool;
+class ChannelPool;
+class GrpcPreparedRequest;
+class GrpcStream;
+
 //==============================================================================
 /// An InferenceServerGrpcClient object is used to perform any kind of
-/// communication with the InferenceServer using gRPC protocol.  Most
-/// of the methods are thread-safe except Infer, AsyncInfer, StartStream
-/// StopStream and AsyncStreamInfer. Calling these functions from different
-/// threads will cause undefined behavior.
+/// communication with the InferenceServer using gRPC protocol. Most
+/// of the methods are thread-safe, including Infer, AsyncInfer, InferMulti
+/// and AsyncInferMulti so a single client can be shared by many threads.
+/// The streaming functions are thread-safe as well, the writes of the
+/// threads sharing a stream are serialized so threads that stream
+/// concurrently should each start a stream of their own.
 ///
 /// \code
 ///   std::unique_ptr<InferenceServerGrpcClient> client;
@@ -110,12 +175,21 @@ class InferenceServerGrpcClient : public InferenceServerClient {
   /// SSL encryption and authorization.
   /// \param keepalive_options Specifies the GRPC KeepAlive options described
   /// in https://grpc.github.io/grpc/cpp/md_doc_keepalive.html
+  /// \param async_options Specifies the settings of the engine performing
+  /// the asynchronous requests, such as the number of completion queues.
+  /// \param arena_options Specifies whether and how the inference messages
+  /// are allocated on pooled protobuf arenas.
+  /// \param channel_pool_options Specifies the pool of channels the
+  /// inference requests are spread over.
   /// \return Error object indicating success or failure.
   static Error Create(
       std::unique_ptr<InferenceServerGrpcClient>* client,
       const std::string& server_url, bool verbose = false, bool use_ssl = false,
       const SslOptions& ssl_options = SslOptions(),
-      const KeepAliveOptions& keepalive_options = KeepAliveOptions());
+      const KeepAliveOptions& keepalive_options = KeepAliveOptions(),
+      const AsyncOptions& async_options = AsyncOptions(),
+      const ArenaOptions& arena_options = ArenaOptions(),
+      const ChannelPoolOptions& channel_pool_options = ChannelPoolOptions());
 
   /// Contact the inference server and get its liveness.
   /// \param live Returns whether the server is live or not.
@@ -343,7 +417,11 @@ class InferenceServerGrpcClient : public InferenceServerClient {
   /// function caller. It is then the caller's choice on either retrieving the
   /// results inside the callback function or deferring it to a different thread
   /// so that the client is unblocked. In order to prevent memory leak, user
-  /// must ensure this object gets deleted.
+  /// must ensure this object gets deleted. The raw input data is copied
+  /// before this function returns unless the client was created with
+  /// AsyncOptions::reference_input_data set, in which case the buffers
+  /// registered with InferInput::AppendRaw must not be modified or released
+  /// until 'callback' is invoked.
   /// \param callback The callback function to be invoked on request completion.
   /// \param options The options for inference request.
   /// \param inputs The vector of InferInput describing the model inputs.
@@ -363,8 +441,78 @@ class InferenceServerGrpcClient : public InferenceServerClient {
       const Headers& headers = Headers(),
       grpc_compression_algorithm compression_algorithm = GRPC_COMPRESS_NONE);
 
-  /// Run multiple synchronous inferences on server.
-  /// \param results Returns the results of the inferences.
+  /// Prepare an inference request to be run any number of times with the
+  /// Infer() and AsyncInfer() functions taking a PreparedRequest. The
+  /// model, the inputs metadata, the requested outputs, the headers and the
+  /// compression algorithm are serialized once. The 'inputs' objects are
+  /// kept by the prepared request and their data is read on each run, so
+  /// the data can be changed between runs but not the byte size of the
+  /// inputs nor the other properties of the tensors.
+  /// \param prepared_request Returns the prepared request.
+  /// \param options The options for inference request, only the model name
+  /// and version are used.
+  /// \param inputs The vector of InferInput describing the model inputs.
+  /// \param outputs Optional vector of InferRequestedOutput describing how
+  /// the output must be returned. If not provided then all the outputs in the
+  /// model config will be returned as default settings.
+  /// \param headers Optional map specifying additional HTTP headers to include
+  /// in the metadata of gRPC request.
+  /// \param compression_algorithm The compression algorithm to be used
+  /// by gRPC when sending requests. By default compression is not used.
+  /// \return Error object indicating success or failure.
+  Error PrepareRequest(
+      std::unique_ptr<PreparedRequest>* prepared_request,
+      const InferOptions& options, const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs =
+          std::vector<const InferRequestedOutput*>(),
+      const Headers& headers = Headers(),
+      grpc_compression_algorithm compression_algorithm = GRPC_COMPRESS_NONE);
+
+  /// Run synchronous inference on server using a prepared request.
+  /// \param result Returns the result of inference.
+  /// \param prepared_request The request prepared by this client.
+  /// \param options The options for inference request. The model name and
+  /// version are ignored in favor of the ones of the prepared request.
+  /// \return Error object indicating success or failure of the
+  /// request.
+  Error Infer(
+      InferResult** result, const PreparedRequest& prepared_request,
+      const InferOptions& options);
+
+  /// Run asynchronous inference on server using a prepared request. The
+  /// prepared request and the data of its inputs must remain valid until
+  /// 'callback' is invoked.
+  /// \param callback The callback function to be invoked on request completion.
+  /// \param prepared_request The request prepared by this client.
+  /// \param options The options for inference request. The model name and
+  /// version are ignored in favor of the ones of the prepared request.
+  /// \return Error object indicating success or failure of the request.
+  Error AsyncInfer(
+      OnCompleteFn callback, const PreparedRequest& prepared_request,
+      const InferOptions& options);
+
+  /// Create a batcher that coalesces the asynchronous inferences run
+  /// through it into batched requests sent by this client. See
+  /// InferBatcher. The batcher must be destroyed before the client.
+  /// \param batcher Returns a new InferBatcher object.
+  /// \param batcher_options The options of the batcher.
+  /// \param headers Optional map specifying additional HTTP headers to
+  /// include in the metadata of the batched requests.
+  /// \param compression_algorithm The compression algorithm to be used
+  /// by gRPC when sending the batched requests.
+  /// \return Error object indicating success or failure.
+  Error CreateInferBatcher(
+      std::unique_ptr<InferBatcher>* batcher,
+      const InferBatcherOptions& batcher_options = InferBatcherOptions(),
+      const Headers& headers = Headers(),
+      grpc_compression_algorithm compression_algorithm = GRPC_COMPRESS_NONE);
+
+  /// Run multiple synchronous inferences on server. All the requests are
+  /// sent concurrently through the asynchronous requests machinery and the
+  /// function returns once all of them are completed. Hence it must not be
+  /// called from the callback of an asynchronous request.
+  /// \param results Returns the results of the inferences, in the same
+  /// order as the requests.
   /// \param options The options for each inference request, one set of
   /// options may be provided and it will be used for all inference requests.
   /// \param inputs The vector of InferInput objects describing the model inputs
@@ -378,7 +526,7 @@ class InferenceServerGrpcClient : public InferenceServerClient {
   /// \param compression_algorithm The compression algorithm to be used
   /// by gRPC when sending requests. By default compression is not used.
   /// \return Error object indicating success or failure of the
-  /// request.
+  /// requests, the error of the first failed request if any.
   Error InferMulti(
       std::vector<InferResult*>* results,
       const std::vector<InferOptions>& options,
@@ -424,9 +572,11 @@ class InferenceServerGrpcClient : public InferenceServerClient {
   /// response at the stream.
   /// \param enable_stats Indicates whether client library should record the
   /// the client-side statistics for inference requests on stream or not.
-  /// The library does not support client side statistics for decoupled
-  /// streaming. Set this option false when there is no 1:1 mapping between
-  /// request and response on the stream.
+  /// The responses are matched with their request by request id, a request
+  /// to a decoupled model completes on the response flagged as final, see
+  /// InferOptions::triton_enable_empty_final_response_, or on its first
+  /// response if the model doesn't flag them. The requests without id are
+  /// assumed to complete in order with a single response each.
   /// \param stream_timeout Specifies the end-to-end timeout for the streaming
   /// connection in microseconds. The default value is 0 which means that
   /// there is no limitation on deadline. The stream will be closed once
@@ -441,10 +591,28 @@ class InferenceServerGrpcClient : public InferenceServerClient {
       uint32_t stream_timeout = 0, const Headers& headers = Headers(),
       grpc_compression_algorithm compression_algorithm = GRPC_COMPRESS_NONE);
 
+  /// Starts an additional grpc bi-directional stream, any number of which
+  /// can run at a time next to the stream of StartStream() without id.
+  /// The streams are opened on the least busy channels of the client.
+  /// \param stream_id Returns the id identifying the stream in
+  /// AsyncStreamInfer() and StopStream().
+  /// See the other overload for the remaining parameters.
+  /// \return Error object indicating success or failure of the request.
+  Error StartStream(
+      size_t* stream_id, OnCompleteFn callback, bool enable_stats = true,
+      uint32_t stream_timeout = 0, const Headers& headers = Headers(),
+      grpc_compression_algorithm compression_algorithm = GRPC_COMPRESS_NONE);
+
   /// Stops an active grpc bi-directional stream, if one available.
   /// \return Error object indicating success or failure of the request.
   Error StopStream();
 
+  /// Stops the grpc bi-directional stream with the given id, once all its
+  /// responses have been received.
+  /// \param stream_id The id of the stream returned by StartStream().
+  /// \return Error object indicating success or failure of the request.
+  Error StopStream(const size_t stream_id);
+
   /// Runs an asynchronous inference over gRPC bi-directional streaming
   /// API. A stream must be established with a call to StartStream()
   /// before calling this function. All the results will be provided to the
@@ -460,37 +628,127 @@ class InferenceServerGrpcClient : public InferenceServerClient {
       const std::vector<const InferRequestedOutput*>& outputs =
           std::vector<const InferRequestedOutput*>());
 
+  /// Runs an asynchronous inference on the stream with the given id. The
+  /// results will be provided to the callback function provided when
+  /// starting that stream.
+  /// \param stream_id The id of the stream returned by StartStream().
+  /// See the other overload for the remaining parameters.
+  /// \return Error object indicating success or failure of the request.
+  Error AsyncStreamInfer(
+      const size_t stream_id, const InferOptions& options,
+      const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs =
+          std::vector<const InferRequestedOutput*>());
+
  private:
   InferenceServerGrpcClient(
       const std::string& url, bool verbose, bool use_ssl,
-      const SslOptions& ssl_options, const KeepAliveOptions& keepalive_options);
+      const SslOptions& ssl_options, const KeepAliveOptions& keepalive_options,
+      const AsyncOptions& async_options, const ArenaOptions& arena_options,
+      const ChannelPoolOptions& channel_pool_options);
+  // Populate 'infer_request'. If 'request_buffer' is provided the raw
+  // input contents are not copied into 'infer_request', instead the
+  // serialized request is placed in 'request_buffer' with slices that
+  // reference the input buffers directly if 'reference_input_data' is true,
+  // or hold a copy of them otherwise. The parts of the request that must be
+  // serialized are placed on 'arena' if provided.
   Error PreRunProcessing(
       const InferOptions& options, const std::vector<InferInput*>& inputs,
-      const std::vector<const InferRequestedOutput*>& outputs);
-  void AsyncTransfer();
-  void AsyncStreamTransfer();
-
-  // The producer-consumer queue used to communicate asynchronously with
-  // the GRPC runtime.
-  grpc::CompletionQueue async_request_completion_queue_;
-
-  // Required to support the grpc bi-directional streaming API.
-  InferenceServerClient::OnCompleteFn stream_callback_;
-  std::thread stream_worker_;
-  std::shared_ptr<grpc::ClientReaderWriter<
-      inference::ModelInferRequest, inference::ModelStreamInferResponse>>
-      grpc_stream_;
-  grpc::ClientContext grpc_context_;
-
-  bool enable_stream_stats_;
-  std::queue<std::unique_ptr<RequestTimers>> ongoing_stream_request_timers_;
-  std::mutex stream_mutex_;
+      const std::vector<const InferRequestedOutput*>& outputs,
+      inference::ModelInferRequest* infer_request,
+      grpc::ByteBuffer* request_buffer = nullptr,
+      google::protobuf::Arena* arena = nullptr,
+      const bool reference_input_data = false);
+  // Place the serialized request in 'request_buffer', with only the
+  // per-call fields taken from 'prepared_request'.
+  Error PreRunProcessing(
+      const GrpcPreparedRequest& prepared_request, const InferOptions& options,
+      grpc::ByteBuffer* request_buffer, google::protobuf::Arena* arena);
+  // Populate the inputs and outputs of 'infer_request', the data of the
+  // inputs is only added if 'copy_raw_contents' is true.
+  void PopulateTensors(
+      const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs,
+      inference::ModelInferRequest* infer_request,
+      const bool copy_raw_contents);
+  // Place in 'request_buffer' the serialized 'infer_request', followed by
+  // the 'prepared_fields' if not nullptr and by the data of the inputs,
+  // which is referenced if 'reference_input_data' is true and copied
+  // otherwise.
+  void SerializeInferRequest(
+      const inference::ModelInferRequest& infer_request,
+      const std::string* prepared_fields,
+      const std::vector<InferInput*>& inputs, grpc::ByteBuffer* request_buffer,
+      google::protobuf::Arena* arena, const bool reference_input_data);
+  // Serialize the request to send into the provided buffer, using the
+  // provided arena if not nullptr.
+  using RequestSerializer = std::function<Error(
+      grpc::ByteBuffer* request_buffer, google::protobuf::Arena* arena)>;
+  Error SendSyncRequest(
+      InferResult** result, const InferOptions& options,
+      const Headers& headers, grpc_compression_algorithm compression_algorithm,
+      const RequestSerializer& serialize_request);
+  Error SendAsyncRequest(
+      OnCompleteFn callback, const InferOptions& options,
+      const Headers& headers, grpc_compression_algorithm compression_algorithm,
+      const RequestSerializer& serialize_request);
+  // Take a request message from the pool, or create one if the pool is
+  // empty, and give it back once it has been serialized.
+  inference::ModelInferRequest* AcquireInferRequest();
+  void ReleaseInferRequest(inference::ModelInferRequest* infer_request);
+  // Return a new response message, allocated on a pooled arena if enabled.
+  std::shared_ptr<inference::ModelInferResponse> NewInferResponse();
+  std::shared_ptr<inference::ModelStreamInferResponse>
+  NewStreamInferResponse();
+  // Start the threads draining the completion queues if not yet running.
+  void StartAsyncWorkers();
+  void AsyncTransfer(grpc::CompletionQueue* completion_queue);
+  // Open a stream registered as 'stream_id' and start its reader thread.
+  Error OpenStream(
+      const size_t stream_id, OnCompleteFn callback, bool enable_stats,
+      uint32_t stream_timeout, const Headers& headers,
+      grpc_compression_algorithm compression_algorithm);
+  void AsyncStreamTransfer(GrpcStream* stream);
+
+  // The producer-consumer queues used to communicate asynchronously with
+  // the GRPC runtime, each drained by the thread of the same index in
+  // 'async_workers_'.
+  std::vector<std::unique_ptr<grpc::CompletionQueue>>
+      async_request_completion_queues_;
+  std::vector<std::thread> async_workers_;
+  std::once_flag async_workers_started_;
+  // The index of the completion queue used by the next asynchronous request
+  std::atomic<size_t> next_completion_queue_;
+  // Whether the raw input data of the asynchronous requests is referenced
+  // instead of copied, see AsyncOptions::reference_input_data.
+  const bool reference_async_input_data_;
+
+  // The running grpc bi-directional streams by id. The stream started
+  // without id is registered as 'kDefaultStreamId'.
+  static constexpr size_t kDefaultStreamId = 0;
+  std::mutex streams_mutex_;
+  std::map<size_t, std::shared_ptr<GrpcStream>> streams_;
+  // Whether the stream started without id is being opened, so that only
+  // one of concurrent StartStream() calls opens it.
+  bool default_stream_opening_;
+  std::atomic<size_t> next_stream_id_;
 
   // GRPC end point.
   std::shared_ptr<inference::GRPCInferenceService::Stub> stub_;
-  // request for GRPC call, one request object can be used for multiple calls
-  // since it can be overwritten as soon as the GRPC send finishes.
-  inference::ModelInferRequest infer_request_;
+  // The channels the inference requests are sent on, through type-unaware
+  // end points as the requests are pre-serialized.
+  std::shared_ptr<ChannelPool> channel_pool_;
+
+  // The pool providing the arenas of the inference messages, nullptr if
+  // arenas are not used. It is shared with the messages allocated from it so
+  // it stays alive as long as any of them.
+  std::shared_ptr<ArenaPool> arena_pool_;
+  // The request messages that are not in use. A message is taken from the
+  // pool for each call, so concurrent calls never share one, and is reused
+  // by later calls once the request has been serialized.
+  std::mutex infer_request_pool_mutex_;
+  std::vector<std::unique_ptr<inference::ModelInferRequest>>
+      infer_request_pool_;
 };
 
 
@@ -29,12 +29,19 @@
 #include "common.h"
 
 #include <curl/curl.h>
-#include <zlib.h>
+#include <algorithm>
 #include <atomic>
 #include <cstdint>
 #include <deque>
+#include <future>
 #include <iostream>
+#include <mutex>
 #include "http_client.h"
+#include "http_compression.h"
+
+#ifdef TRITON_ENABLE_LZ4
+#include <lz4frame.h>
+#endif  // TRITON_ENABLE_LZ4
 
 extern "C" {
 #include "cencode.h"
@@ -54,6 +61,17 @@ namespace triton { namespace client {
 namespace {
 
 constexpr char kContentLengthHTTPHeader[] = "Content-Length";
+constexpr char kContentEncodingHTTPHeader[] = "Content-Encoding";
+
+// The scheme of a server url naming a Unix domain socket, and the url the
+// requests are then addressed to.
+constexpr char kUnixSocketScheme[] = "unix://";
+constexpr char kUnixSocketServerUrl[] = "http://localhost";
+
+// The maximum time the asynchronous worker waits for socket activity
+// before checking the transfers again. libcurl shortens the wait if one of
+// its internal timers expires earlier.
+constexpr int kAsyncPollTimeoutMs = 1000;
 
 //==============================================================================
 
@@ -130,84 +148,67 @@ Base64Encode(
   *encoded_size += padding_size;
 }
 
-// libcurl provides automatic decompression, so only implement compression
+#ifdef TRITON_ENABLE_LZ4
+// libcurl doesn't decode lz4, the response body is decoded as it is
+// received instead.
+class Lz4Decompressor {
+ public:
+  Lz4Decompressor() : dctx_(nullptr) {}
+  ~Lz4Decompressor() { LZ4F_freeDecompressionContext(dctx_); }
+
+  Error Init();
+  // Decompress 'byte_size' bytes of 'buf', passing the decompressed data to
+  // 'append' as it is produced.
+  Error Decompress(
+      const char* buf, size_t byte_size,
+      const std::function<void(const char*, size_t)>& append);
+
+ private:
+  static constexpr size_t kDecompressedByteSize = 256 * 1024;
+
+  LZ4F_dctx* dctx_;
+  std::vector<char> decompressed_;
+};
+
+constexpr size_t Lz4Decompressor::kDecompressedByteSize;
+
 Error
-CompressData(
-    const InferenceServerHttpClient::CompressionType type,
-    const std::deque<std::pair<uint8_t*, size_t>>& source,
-    const size_t source_byte_size,
-    std::vector<std::pair<std::unique_ptr<char[]>, size_t>>* compressed_data)
-{
-  // nothing to be compressed
-  if (source_byte_size == 0) {
-    return Error("nothing to be compressed");
-  }
-
-  z_stream stream;
-  stream.zalloc = Z_NULL;
-  stream.zfree = Z_NULL;
-  stream.opaque = Z_NULL;
-  switch (type) {
-    case InferenceServerHttpClient::CompressionType::GZIP:
-      if (deflateInit2(
-              &stream, Z_DEFAULT_COMPRESSION /* level */,
-              Z_DEFLATED /* method */, 15 | 16 /* windowBits */,
-              8 /* memLevel */, Z_DEFAULT_STRATEGY /* strategy */) != Z_OK) {
-        return Error("failed to initialize state for gzip data compression");
-      }
-      break;
-    case InferenceServerHttpClient::CompressionType::DEFLATE: {
-      if (deflateInit(&stream, Z_DEFAULT_COMPRESSION /* level */) != Z_OK) {
-        return Error("failed to initialize state for deflate data compression");
-      }
-      break;
-    }
-    case InferenceServerHttpClient::CompressionType::NONE:
-      return Error("can't compress data with NONE type");
-      break;
-  }
-  // ensure the internal state are cleaned up on function return
-  std::unique_ptr<z_stream, decltype(&deflateEnd)> managed_stream(
-      &stream, deflateEnd);
-
-  // Reserve the same size as source for compressed data, it is less likely
-  // that a negative compression happens.
-  std::unique_ptr<char[]> current_reserved_space(new char[source_byte_size]);
-  stream.next_out =
-      reinterpret_cast<unsigned char*>(current_reserved_space.get());
-  stream.avail_out = source_byte_size;
-
-  // Compress until end of 'source'
-  for (auto it = source.begin(); it != source.end(); ++it) {
-    stream.next_in = reinterpret_cast<unsigned char*>(it->first);
-    stream.avail_in = it->second;
-
-    // run deflate() on input until source has been read in
-    do {
-      // Need additional buffer
-      if (stream.avail_out == 0) {
-        compressed_data->emplace_back(
-            std::move(current_reserved_space), source_byte_size);
-        current_reserved_space.reset(new char[source_byte_size]);
-        stream.next_out =
-            reinterpret_cast<unsigned char*>(current_reserved_space.get());
-        stream.avail_out = source_byte_size;
-      }
-      auto flush = (std::next(it) == source.end()) ? Z_FINISH : Z_NO_FLUSH;
-      auto ret = deflate(&stream, flush);
-      if (ret == Z_STREAM_ERROR) {
-        return Error(
-            "encountered inconsistent stream state during compression");
-      }
-    } while (stream.avail_out == 0);
+Lz4Decompressor::Init()
+{
+  if (LZ4F_isError(LZ4F_createDecompressionContext(&dctx_, LZ4F_VERSION))) {
+    return Error("failed to initialize state for lz4 data decompression");
   }
-  // Make sure the last buffer is committed
-  if (current_reserved_space != nullptr) {
-    compressed_data->emplace_back(
-        std::move(current_reserved_space), source_byte_size - stream.avail_out);
+  decompressed_.resize(kDecompressedByteSize);
+  return Error::Success;
+}
+
+Error
+Lz4Decompressor::Decompress(
+    const char* buf, size_t byte_size,
+    const std::function<void(const char*, size_t)>& append)
+{
+  // Keep going while there is input or the output buffer was filled, in
+  // which case more decompressed data may be pending.
+  bool more = true;
+  while (more) {
+    size_t dst_size = decompressed_.size();
+    size_t src_size = byte_size;
+    const size_t ret = LZ4F_decompress(
+        dctx_, decompressed_.data(), &dst_size, buf, &src_size, nullptr);
+    if (LZ4F_isError(ret)) {
+      return Error(
+          std::string("failed to decompress data: ") + LZ4F_getErrorName(ret));
+    }
+    if (dst_size > 0) {
+      append(decompressed_.data(), dst_size);
+    }
+    buf += src_size;
+    byte_size -= src_size;
+    more = (byte_size > 0) || (dst_size == decompressed_.size());
   }
   return Error::Success;
 }
+#endif  // TRITON_ENABLE_LZ4
 
 Error
 ParseSslCertType(
@@ -276,10 +277,91 @@ SetSSLCurlOptions(CURL** curl, const HttpSslOptions& ssl_options)
   return Error::Success;
 }
 
+void
+SetTransportCurlOptions(
+    CURL* curl, const std::string& url,
+    const HttpTransportOptions& transport_options)
+{
+  if (!transport_options.unix_socket_path.empty()) {
+    curl_easy_setopt(
+        curl, CURLOPT_UNIX_SOCKET_PATH,
+        transport_options.unix_socket_path.c_str());
+  }
+  if (transport_options.protocol == HttpTransportOptions::PROTOCOL::HTTP2) {
+    // Plain-text connections can't negotiate the protocol, so assume the
+    // server speaks HTTP/2 (h2c). Encrypted connections negotiate it via ALPN.
+    const bool use_tls = (url.rfind("https://", 0) == 0);
+    curl_easy_setopt(
+        curl, CURLOPT_HTTP_VERSION,
+        use_tls ? CURL_HTTP_VERSION_2TLS : CURL_HTTP_VERSION_2_PRIOR_KNOWLEDGE);
+  }
+}
+
+// Append to 'list' the headers of an inference request that don't depend on
+// the request JSON and return the new list.
+struct curl_slist*
+AppendInferHeaders(
+    struct curl_slist* list, const Headers& headers,
+    const InferenceServerHttpClient::CompressionType
+        request_compression_algorithm)
+{
+  list = curl_slist_append(list, "Expect:");
+  list = curl_slist_append(list, "Content-Type: application/octet-stream");
+  for (const auto& pr : headers) {
+    std::string hdr = pr.first + ": " + pr.second;
+    list = curl_slist_append(list, hdr.c_str());
+  }
+
+  switch (request_compression_algorithm) {
+    case InferenceServerHttpClient::CompressionType::NONE:
+      break;
+    case InferenceServerHttpClient::CompressionType::DEFLATE:
+      list = curl_slist_append(list, "Content-Encoding: deflate");
+      break;
+    case InferenceServerHttpClient::CompressionType::GZIP:
+      list = curl_slist_append(list, "Content-Encoding: gzip");
+      break;
+    case InferenceServerHttpClient::CompressionType::ZSTD:
+      list = curl_slist_append(list, "Content-Encoding: zstd");
+      break;
+    case InferenceServerHttpClient::CompressionType::LZ4:
+      list = curl_slist_append(list, "Content-Encoding: lz4");
+      break;
+  }
+
+  return list;
+}
+
+// A caller-owned buffer that the binary data of a requested output is
+// written to as the response is received.
+struct OutputDestination {
+  std::string name_;
+  uint8_t* buf_;
+  size_t byte_size_;
+};
+
+std::vector<OutputDestination>
+OutputDestinations(const std::vector<const InferRequestedOutput*>& outputs)
+{
+  std::vector<OutputDestination> destinations;
+  for (const auto io : outputs) {
+    void* buf;
+    size_t byte_size;
+    if (io->HasDestinationBuffer() &&
+        io->DestinationBuffer(&buf, &byte_size).IsOk()) {
+      destinations.push_back(
+          OutputDestination{io->Name(), (uint8_t*)buf, byte_size});
+    }
+  }
+  return destinations;
+}
+
 }  // namespace
 
 //==============================================================================
 
+class HttpPreparedRequest;
+
 class HttpInferRequest : public InferRequest {
  public:
   HttpInferRequest(
@@ -291,15 +373,23 @@ class HttpInferRequest : public InferRequest {
   Error InitializeRequest(
       const InferOptions& options, const std::vector<InferInput*>& inputs,
       const std::vector<const InferRequestedOutput*>& outputs);
+  // Initialize the request for HTTP transfer from a prepared request, only
+  // the per-call members of the request JSON are serialized.
+  Error InitializeRequest(
+      const HttpPreparedRequest& prepared_request, const InferOptions& options);
 
   // Adds the input data to be delivered to the server
   Error AddInput(uint8_t* buf, size_t byte_size);
 
   // Copy into 'buf' up to 'size' bytes of input data. Return the
-  // actual amount copied in 'input_bytes'.
+  // actual amount copied in 'input_bytes'. If the input is compressed,
+  // the compressed data is produced as it is copied.
   Error GetNextInput(uint8_t* buf, size_t size, size_t* input_bytes);
 
+  // Compress the input data with 'type' while it is sent. The size of the
+  // compressed data is not known until it is all sent.
   Error CompressInput(const InferenceServerHttpClient::CompressionType type);
+  bool IsInputCompressed() const { return (compressor_ != nullptr); }
 
  private:
   friend class InferenceServerHttpClient;
@@ -309,6 +399,29 @@ class HttpInferRequest : public InferRequest {
       const InferOptions& options, const std::vector<InferInput*>& inputs,
       const std::vector<const InferRequestedOutput*>& outputs,
       triton::common::TritonJson::Value* request_json);
+  // Add the members of the request JSON that may change on each call, the
+  // "id" and the "parameters".
+  static Error PrepareRequestParametersJson(
+      const InferOptions& options, const bool outputs_empty,
+      triton::common::TritonJson::Value* request_json);
+  // Add the members of the request JSON that describe the tensors, the
+  // "inputs" and the "outputs".
+  static Error PrepareRequestTensorsJson(
+      const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs,
+      triton::common::TritonJson::Value* request_json);
+
+  // The serialized request JSON, delivered ahead of the input data
+  size_t RequestJsonSize() const;
+  std::string RequestJson() const;
+
+  // Reserve the response buffer once the response headers are received.
+  void ReserveResponseBuffer();
+  // Append a chunk of the response body, writing the binary data of the
+  // outputs with a destination buffer directly to that buffer.
+  void AppendResponse(const char* buf, size_t byte_size);
+  // Parse the response JSON and lay out the binary data that follows it.
+  void RouteResponse();
 
   // Pointer to the list of the HTTP request header, keep it such that it will
   // be valid during the transfer and can be freed once transfer is completed.
@@ -320,24 +433,111 @@ class HttpInferRequest : public InferRequest {
   size_t total_input_byte_size_;
 
   triton::common::TritonJson::WriteBuffer request_json_;
+  // The request JSON when initialized from a prepared request, made of the
+  // per-call members followed by the prepared ones.
+  std::string prepared_json_;
+
+  // The header holding the size of the request JSON when initialized from a
+  // prepared request. It is linked in front of the prepared header list
+  // instead of copying the list.
+  std::string infer_header_;
+  struct curl_slist infer_header_node_;
 
   // Buffer that accumulates the response body.
   std::unique_ptr<std::string> infer_response_buffer_;
+  // The size of the response body as reported by the server, 0 if
+  // unknown.
+  size_t response_content_length_;
+
+  // The caller-owned buffers of the requested outputs.
+  std::vector<OutputDestination> output_destinations_;
+
+  // The binary data of each output in the response, in order, written to
+  // 'buf_' or to the response buffer if 'buf_' is nullptr. Only laid out if
+  // there are output destinations, once the response JSON is received.
+  struct ResponseSegment {
+    uint8_t* buf_;
+    size_t byte_size_;
+  };
+  bool response_routed_;
+  std::vector<ResponseSegment> response_segments_;
+  size_t response_segment_idx_;
+  size_t response_segment_offset_;
+
+  // The response JSON if parsed while laying out the response segments.
+  bool response_json_parsed_;
+  triton::common::TritonJson::Value response_json_;
 
   // The pointers to the input data.
   std::deque<std::pair<uint8_t*, size_t>> data_buffers_;
 
-  // Placeholder for the compressed data
-  std::vector<std::pair<std::unique_ptr<char[]>, size_t>> compressed_data_;
+  // Compresses the input data while it is sent, nullptr if the input is
+  // sent uncompressed.
+  std::unique_ptr<RequestCompressor> compressor_;
+
+#ifdef TRITON_ENABLE_LZ4
+  // Whether the response may be encoded with lz4, and the decompressor once
+  // the server has responded with an lz4 encoded body.
+  bool accept_lz4_response_;
+  std::unique_ptr<Lz4Decompressor> response_decompressor_;
+#endif  // TRITON_ENABLE_LZ4
 
   size_t response_json_size_;
 };
 
+//==============================================================================
+
+class HttpPreparedRequest : public PreparedRequest {
+ public:
+  HttpPreparedRequest(const std::string& model_name)
+      : PreparedRequest(model_name), outputs_empty_(true),
+        header_list_(nullptr),
+        request_compression_algorithm_(
+            InferenceServerHttpClient::CompressionType::NONE),
+        response_compression_algorithm_(
+            InferenceServerHttpClient::CompressionType::NONE)
+  {
+  }
+  ~HttpPreparedRequest();
+
+ private:
+  friend class InferenceServerHttpClient;
+  friend class HttpInferRequest;
+
+  // The inference endpoint, including the query string
+  std::string request_uri_;
+  bool outputs_empty_;
+  // The serialized "inputs" and "outputs" members of the request JSON,
+  // without the opening brace. Empty if the request has neither.
+  std::string tensors_json_;
+  // The destination buffers of the outputs, captured when prepared
+  std::vector<OutputDestination> output_destinations_;
+  // The HTTP headers that don't depend on the request JSON
+  struct curl_slist* header_list_;
+  InferenceServerHttpClient::CompressionType request_compression_algorithm_;
+  InferenceServerHttpClient::CompressionType response_compression_algorithm_;
+};
+
+HttpPreparedRequest::~HttpPreparedRequest()
+{
+  if (header_list_ != nullptr) {
+    curl_slist_free_all(header_list_);
+    header_list_ = nullptr;
+  }
+}
+
+//==============================================================================
 
 HttpInferRequest::HttpInferRequest(
     InferenceServerClient::OnCompleteFn callback, const bool verbose)
     : InferRequest(callback, verbose), header_list_(nullptr),
-      total_input_byte_size_(0), response_json_size_(0)
+      total_input_byte_size_(0), response_content_length_(0),
+      response_routed_(false), response_segment_idx_(0),
+      response_segment_offset_(0), response_json_parsed_(false),
+#ifdef TRITON_ENABLE_LZ4
+      accept_lz4_response_(false),
+#endif  // TRITON_ENABLE_LZ4
+      response_json_size_(0)
 {
 }
 
@@ -373,15 +573,191 @@ HttpInferRequest::InitializeRequest(
 
   // Prepare buffer to record the response
   infer_response_buffer_.reset(new std::string());
+  output_destinations_ = OutputDestinations(outputs);
+
+  return Error::Success;
+}
+
+Error
+HttpInferRequest::InitializeRequest(
+    const HttpPreparedRequest& prepared_request, const InferOptions& options)
+{
+  data_buffers_ = {};
+  total_input_byte_size_ = 0;
+  http_code_ = 400;
+
+  triton::common::TritonJson::Value request_json(
+      triton::common::TritonJson::ValueType::OBJECT);
+  Error err = PrepareRequestParametersJson(
+      options, prepared_request.outputs_empty_, &request_json);
+  if (!err.IsOk()) {
+    return err;
+  }
+
+  request_json_.Clear();
+  request_json.Write(&request_json_);
+
+  // Replace the closing brace of the per-call members, there is always at
+  // least the "id", with the prepared members.
+  prepared_json_.assign(request_json_.Base(), request_json_.Size() - 1);
+  if (prepared_request.tensors_json_.empty()) {
+    prepared_json_ += '}';
+  } else {
+    prepared_json_ += ',';
+    prepared_json_ += prepared_request.tensors_json_;
+  }
+
+  // Add the buffer holding the json to be delivered first
+  AddInput((uint8_t*)prepared_json_.data(), prepared_json_.size());
+
+  // Prepare buffer to record the response
+  infer_response_buffer_.reset(new std::string());
+  output_destinations_ = prepared_request.output_destinations_;
 
   return Error::Success;
 }
 
+size_t
+HttpInferRequest::RequestJsonSize() const
+{
+  return prepared_json_.empty() ? request_json_.Size() : prepared_json_.size();
+}
+
+std::string
+HttpInferRequest::RequestJson() const
+{
+  return prepared_json_.empty() ? std::string(request_json_.Contents())
+                                : prepared_json_;
+}
+
+void
+HttpInferRequest::ReserveResponseBuffer()
+{
+  // Only the response JSON and the outputs without a destination buffer are
+  // kept in the response buffer, the latter is reserved once the response
+  // JSON is parsed.
+  if (!output_destinations_.empty() && (response_json_size_ != 0)) {
+    infer_response_buffer_->reserve(response_json_size_);
+  } else if (response_content_length_ != 0) {
+    infer_response_buffer_->reserve(response_content_length_);
+  }
+}
+
+void
+HttpInferRequest::AppendResponse(const char* buf, size_t byte_size)
+{
+  if (!response_routed_) {
+    if (output_destinations_.empty() || (response_json_size_ == 0) ||
+        ((infer_response_buffer_->size() + byte_size) <
+         response_json_size_)) {
+      infer_response_buffer_->append(buf, byte_size);
+      return;
+    }
+
+    const size_t json_bytes =
+        response_json_size_ - infer_response_buffer_->size();
+    infer_response_buffer_->append(buf, json_bytes);
+    buf += json_bytes;
+    byte_size -= json_bytes;
+    RouteResponse();
+  }
+
+  while ((byte_size > 0) &&
+         (response_segment_idx_ < response_segments_.size())) {
+    const auto& segment = response_segments_[response_segment_idx_];
+    const size_t segment_bytes =
+        (std::min)(segment.byte_size_ - response_segment_offset_, byte_size);
+    if (segment.buf_ != nullptr) {
+      std::copy(
+          buf, buf + segment_bytes, segment.buf_ + response_segment_offset_);
+    } else {
+      infer_response_buffer_->append(buf, segment_bytes);
+    }
+    buf += segment_bytes;
+    byte_size -= segment_bytes;
+    response_segment_offset_ += segment_bytes;
+    if (response_segment_offset_ == segment.byte_size_) {
+      ++response_segment_idx_;
+      response_segment_offset_ = 0;
+    }
+  }
+
+  // Any data beyond the described outputs is kept as is.
+  if (byte_size > 0) {
+    infer_response_buffer_->append(buf, byte_size);
+  }
+}
+
+void
+HttpInferRequest::RouteResponse()
+{
+  response_routed_ = true;
+
+  // If the response JSON can't be parsed, all of the response is kept in
+  // the response buffer and the error is reported by the result.
+  response_json_parsed_ =
+      response_json_
+          .Parse(infer_response_buffer_->data(), response_json_size_)
+          .IsOk();
+  if (!response_json_parsed_) {
+    return;
+  }
+
+  size_t buffered_byte_size = 0;
+  triton::common::TritonJson::Value outputs_json;
+  if (response_json_.Find("outputs", &outputs_json)) {
+    for (size_t i = 0; i < outputs_json.ArraySize(); i++) {
+      triton::common::TritonJson::Value output_json;
+      triton::common::TritonJson::Value param_json;
+      uint64_t data_size = 0;
+      const char* name_str;
+      size_t name_strlen;
+      if (!outputs_json.IndexAsObject(i, &output_json).IsOk() ||
+          !output_json.Find("parameters", &param_json) ||
+          !param_json.MemberAsUInt("binary_data_size", &data_size).IsOk() ||
+          !output_json.MemberAsString("name", &name_str, &name_strlen)
+               .IsOk()) {
+        continue;
+      }
+
+      const std::string output_name(name_str, name_strlen);
+      ResponseSegment segment{nullptr, data_size};
+      for (const auto& destination : output_destinations_) {
+        if ((destination.name_ == output_name) &&
+            (destination.byte_size_ >= data_size)) {
+          segment.buf_ = destination.buf_;
+          break;
+        }
+      }
+      if (segment.buf_ == nullptr) {
+        buffered_byte_size += data_size;
+      }
+      response_segments_.push_back(segment);
+    }
+  }
+
+  infer_response_buffer_->reserve(response_json_size_ + buffered_byte_size);
+}
+
 Error
 HttpInferRequest::PrepareRequestJson(
     const InferOptions& options, const std::vector<InferInput*>& inputs,
     const std::vector<const InferRequestedOutput*>& outputs,
     triton::common::TritonJson::Value* request_json)
+{
+  Error err =
+      PrepareRequestParametersJson(options, outputs.empty(), request_json);
+  if (!err.IsOk()) {
+    return err;
+  }
+
+  return PrepareRequestTensorsJson(inputs, outputs, request_json);
+}
+
+Error
+HttpInferRequest::PrepareRequestParametersJson(
+    const InferOptions& options, const bool outputs_empty,
+    triton::common::TritonJson::Value* request_json)
 {
   // Can use string-ref because json is serialized before end of
   // 'options', 'inputs' and 'outputs' lifetime.
@@ -390,7 +766,7 @@ HttpInferRequest::PrepareRequestJson(
 
   if ((options.sequence_id_ != 0) || (options.sequence_id_str_ != "") ||
       (options.priority_ != 0) || (options.server_timeout_ != 0) ||
-      outputs.empty()) {
+      outputs_empty) {
     triton::common::TritonJson::Value parameters_json(
         *request_json, triton::common::TritonJson::ValueType::OBJECT);
     {
@@ -415,7 +791,7 @@ HttpInferRequest::PrepareRequestJson(
 
       // If no outputs are provided then set the request parameter
       // to return all outputs as binary data.
-      if (outputs.empty()) {
+      if (outputs_empty) {
         parameters_json.AddBool("binary_data_output", true);
       }
     }
@@ -423,6 +799,15 @@ HttpInferRequest::PrepareRequestJson(
     request_json->Add("parameters", std::move(parameters_json));
   }
 
+  return Error::Success;
+}
+
+Error
+HttpInferRequest::PrepareRequestTensorsJson(
+    const std::vector<InferInput*>& inputs,
+    const std::vector<const InferRequestedOutput*>& outputs,
+    triton::common::TritonJson::Value* request_json)
+{
   if (!inputs.empty()) {
     triton::common::TritonJson::Value inputs_json(
         *request_json, triton::common::TritonJson::ValueType::ARRAY);
@@ -531,6 +916,14 @@ HttpInferRequest::GetNextInput(uint8_t* buf, size_t size, size_t* input_bytes)
 {
   *input_bytes = 0;
 
+  if (compressor_ != nullptr) {
+    Error err = compressor_->Compress(&data_buffers_, buf, size, input_bytes);
+    if (err.IsOk() && compressor_->Finished() && (*input_bytes < size)) {
+      Timer().CaptureTimestamp(RequestTimers::Kind::SEND_END);
+    }
+    return err;
+  }
+
   if (data_buffers_.empty()) {
     return Error::Success;
   }
@@ -565,19 +958,7 @@ Error
 HttpInferRequest::CompressInput(
     const InferenceServerHttpClient::CompressionType type)
 {
-  auto err = CompressData(
-      type, data_buffers_, total_input_byte_size_, &compressed_data_);
-  if (!err.IsOk()) {
-    return err;
-  }
-  data_buffers_.clear();
-  total_input_byte_size_ = 0;
-  for (const auto& data : compressed_data_) {
-    data_buffers_.push_back(std::pair<uint8_t*, size_t>(
-        reinterpret_cast<uint8_t*>(data.first.get()), data.second));
-    total_input_byte_size_ += data.second;
-  }
-  return Error::Success;
+  return RequestCompressor::Create(type, &compressor_);
 }
 
 //==============================================================================
@@ -610,10 +991,28 @@ class InferResultHttp : public InferResult {
   InferResultHttp(std::shared_ptr<HttpInferRequest> infer_request);
   InferResultHttp(const Error err) : status_(err) {}
 
-  std::map<std::string, triton::common::TritonJson::Value>
-      output_name_to_result_map_;
-  std::map<std::string, std::pair<const uint8_t*, const size_t>>
-      output_name_to_buffer_map_;
+  // An output in the response. 'buf_' is only set if the output data is
+  // returned as binary data.
+  struct Output {
+    std::string name_;
+    triton::common::TritonJson::Value json_;
+    bool binary_;
+    const uint8_t* buf_;
+    size_t byte_size_;
+  };
+
+  // Find the output named 'output_name'. The outputs are indexed on the
+  // first call so that a response is not indexed unless its outputs are
+  // read.
+  Error FindOutput(const std::string& output_name, const Output** output)
+      const;
+  void IndexOutputs() const;
+
+  // The outputs in response order. Responses have a handful of outputs so
+  // a linear scan is cheaper than a map.
+  mutable std::once_flag outputs_indexed_;
+  mutable Error outputs_status_;
+  mutable std::vector<Output> outputs_;
 
   Error status_;
   triton::common::TritonJson::Value response_json_;
@@ -735,13 +1134,13 @@ InferResultHttp::Shape(
   }
 
   shape->clear();
-  auto itr = output_name_to_result_map_.find(output_name);
-  if (itr == output_name_to_result_map_.end()) {
-    return Error(
-        "The response does not contain results for output name " + output_name);
+  const Output* output;
+  Error err = FindOutput(output_name, &output);
+  if (!err.IsOk()) {
+    return err;
   }
 
-  return ShapeHelper(output_name, itr->second, shape);
+  return ShapeHelper(output_name, output->json_, shape);
 }
 
 Error
@@ -751,15 +1150,15 @@ InferResultHttp::Datatype(
   if (!status_.IsOk()) {
     return status_;
   }
-  auto itr = output_name_to_result_map_.find(output_name);
-  if (itr == output_name_to_result_map_.end()) {
-    return Error(
-        "The response does not contain results for output name " + output_name);
+  const Output* output;
+  Error err = FindOutput(output_name, &output);
+  if (!err.IsOk()) {
+    return err;
   }
 
   const char* dtype_str;
   size_t dtype_strlen;
-  Error err = itr->second.MemberAsString("datatype", &dtype_str, &dtype_strlen);
+  err = output->json_.MemberAsString("datatype", &dtype_str, &dtype_strlen);
   if (!err.IsOk()) {
     return Error(
         "The response does not contain datatype for output name " +
@@ -778,15 +1177,19 @@ InferResultHttp::RawData(
   if (!status_.IsOk()) {
     return status_;
   }
-  auto itr = output_name_to_buffer_map_.find(output_name);
-  if (itr != output_name_to_buffer_map_.end()) {
-    *buf = itr->second.first;
-    *byte_size = itr->second.second;
-  } else {
+  const Output* output;
+  Error err = FindOutput(output_name, &output);
+  if (!err.IsOk()) {
+    return err;
+  }
+  if (!output->binary_) {
     return Error(
         "The response does not contain results for output name " + output_name);
   }
 
+  *buf = output->buf_;
+  *byte_size = output->byte_size_;
+
   return Error::Success;
 }
 
@@ -863,8 +1266,14 @@ InferResultHttp::InferResultHttp(
                   << infer_request->infer_response_buffer_->substr(0, offset)
                   << std::endl;
       }
-      status_ = response_json_.Parse(
-          (char*)infer_request->infer_response_buffer_.get()->c_str(), offset);
+      if (infer_request->response_json_parsed_) {
+        response_json_ = std::move(infer_request->response_json_);
+        infer_request->response_json_parsed_ = false;
+      } else {
+        status_ = response_json_.Parse(
+            (char*)infer_request->infer_response_buffer_.get()->c_str(),
+            offset);
+      }
     } else {
       if (infer_request->verbose_) {
         std::cout << "inference response: "
@@ -887,47 +1296,88 @@ InferResultHttp::InferResultHttp(
       } else {
         status_ = Error(std::string(err_str, err_strlen));
       }
-    } else {
-      triton::common::TritonJson::Value outputs_json;
-      if (response_json_.Find("outputs", &outputs_json)) {
-        for (size_t i = 0; i < outputs_json.ArraySize(); i++) {
-          triton::common::TritonJson::Value output_json;
-          status_ = outputs_json.IndexAsObject(i, &output_json);
-          if (!status_.IsOk()) {
-            break;
-          }
-
-          const char* name_str;
-          size_t name_strlen;
-          status_ = output_json.MemberAsString("name", &name_str, &name_strlen);
-          if (!status_.IsOk()) {
-            break;
-          }
-
-          std::string output_name(name_str, name_strlen);
-
-          triton::common::TritonJson::Value param_json;
-          if (output_json.Find("parameters", &param_json)) {
-            uint64_t data_size = 0;
-            status_ = param_json.MemberAsUInt("binary_data_size", &data_size);
-            if (!status_.IsOk()) {
-              break;
-            }
-
-            output_name_to_buffer_map_.emplace(
-                output_name,
-                std::pair<const uint8_t*, const size_t>(
-                    (uint8_t*)(infer_request->infer_response_buffer_.get()
-                                   ->c_str()) +
-                        offset,
-                    data_size));
-            offset += data_size;
-          }
-
-          output_name_to_result_map_[output_name] = std::move(output_json);
-        }
+    }
+  }
+}
+
+Error
+InferResultHttp::FindOutput(
+    const std::string& output_name, const Output** output) const
+{
+  std::call_once(outputs_indexed_, &InferResultHttp::IndexOutputs, this);
+  if (!outputs_status_.IsOk()) {
+    return outputs_status_;
+  }
+
+  for (const auto& candidate : outputs_) {
+    if (candidate.name_ == output_name) {
+      *output = &candidate;
+      return Error::Success;
+    }
+  }
+
+  return Error(
+      "The response does not contain results for output name " + output_name);
+}
+
+void
+InferResultHttp::IndexOutputs() const
+{
+  triton::common::TritonJson::Value outputs_json;
+  if (!const_cast<triton::common::TritonJson::Value&>(response_json_)
+           .Find("outputs", &outputs_json)) {
+    return;
+  }
+
+  // The binary data of the outputs follows the response JSON in output
+  // order, except for the outputs written to a destination buffer.
+  const auto& segments = infer_request_->response_segments_;
+  size_t segment_idx = 0;
+  const uint8_t* base =
+      (const uint8_t*)infer_request_->infer_response_buffer_->c_str();
+  size_t offset = infer_request_->response_json_size_;
+
+  outputs_.reserve(outputs_json.ArraySize());
+  for (size_t i = 0; i < outputs_json.ArraySize(); i++) {
+    triton::common::TritonJson::Value output_json;
+    outputs_status_ = outputs_json.IndexAsObject(i, &output_json);
+    if (!outputs_status_.IsOk()) {
+      break;
+    }
+
+    const char* name_str;
+    size_t name_strlen;
+    outputs_status_ =
+        output_json.MemberAsString("name", &name_str, &name_strlen);
+    if (!outputs_status_.IsOk()) {
+      break;
+    }
+
+    Output output{std::string(name_str, name_strlen), {}, false, nullptr, 0};
+
+    triton::common::TritonJson::Value param_json;
+    if (output_json.Find("parameters", &param_json)) {
+      uint64_t data_size = 0;
+      outputs_status_ =
+          param_json.MemberAsUInt("binary_data_size", &data_size);
+      if (!outputs_status_.IsOk()) {
+        break;
+      }
+
+      output.binary_ = true;
+      output.byte_size_ = data_size;
+      if ((segment_idx < segments.size()) &&
+          (segments[segment_idx].buf_ != nullptr)) {
+        output.buf_ = segments[segment_idx].buf_;
+      } else {
+        output.buf_ = base + offset;
+        offset += data_size;
       }
+      ++segment_idx;
     }
+
+    output.json_ = std::move(output_json);
+    outputs_.emplace_back(std::move(output));
   }
 }
 
@@ -1005,43 +1455,95 @@ Error
 InferenceServerHttpClient::Create(
     std::unique_ptr<InferenceServerHttpClient>* client,
     const std::string& server_url, bool verbose,
-    const HttpSslOptions& ssl_options)
+    const HttpSslOptions& ssl_options, const HttpAsyncOptions& async_options,
+    const HttpTransportOptions& transport_options)
 {
-  client->reset(
-      new InferenceServerHttpClient(server_url, verbose, ssl_options));
+  if (server_url.rfind(kUnixSocketScheme, 0) == 0) {
+    HttpTransportOptions unix_socket_options(transport_options);
+    unix_socket_options.unix_socket_path =
+        server_url.substr(strlen(kUnixSocketScheme));
+    if (unix_socket_options.unix_socket_path.empty()) {
+      return Error("the socket path is missing in url '" + server_url + "'");
+    }
+    client->reset(new InferenceServerHttpClient(
+        kUnixSocketServerUrl, verbose, ssl_options, async_options,
+        unix_socket_options));
+    return Error::Success;
+  }
+
+  client->reset(new InferenceServerHttpClient(
+      server_url, verbose, ssl_options, async_options, transport_options));
   return Error::Success;
 }
 
 InferenceServerHttpClient::InferenceServerHttpClient(
-    const std::string& url, bool verbose, const HttpSslOptions& ssl_options)
+    const std::string& url, bool verbose, const HttpSslOptions& ssl_options,
+    const HttpAsyncOptions& async_options,
+    const HttpTransportOptions& transport_options)
     : InferenceServerClient(verbose), url_(url), ssl_options_(ssl_options),
+      async_options_(async_options), transport_options_(transport_options),
       easy_handle_(reinterpret_cast<void*>(curl_easy_init())),
-      multi_handle_(curl_multi_init())
+      next_async_shard_(0)
 {
+  easy_handle_pool_.reserve(async_options_.easy_handle_pool_size);
+
+  const size_t shard_count = (std::max)(async_options_.worker_count, size_t(1));
+  for (size_t i = 0; i < shard_count; ++i) {
+    async_shards_.emplace_back(new AsyncShard());
+    CURLM* multi_handle = curl_multi_init();
+    async_shards_.back()->multi_handle_ = multi_handle;
+    if (multi_handle == nullptr) {
+      continue;
+    }
+    if (transport_options_.max_connections > 0) {
+      curl_multi_setopt(
+          multi_handle, CURLMOPT_MAX_HOST_CONNECTIONS,
+          transport_options_.max_connections);
+    }
+    if (transport_options_.protocol == HttpTransportOptions::PROTOCOL::HTTP2) {
+      curl_multi_setopt(multi_handle, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+      curl_multi_setopt(
+          multi_handle, CURLMOPT_MAX_CONCURRENT_STREAMS,
+          transport_options_.max_concurrent_streams);
+    }
+  }
 }
 
 InferenceServerHttpClient::~InferenceServerHttpClient()
 {
+  WaitForPendingCallbacks();
   exiting_ = true;
 
-  // thread not joinable if AsyncInfer() is not called
-  // (it is default constructed thread before the first AsyncInfer() call)
-  if (worker_.joinable()) {
-    cv_.notify_all();
-    worker_.join();
+  for (auto& shard : async_shards_) {
+    // thread not joinable if no AsyncInfer() is assigned to the shard
+    // (it is default constructed thread before the first request)
+    if (shard->worker_.joinable()) {
+      {
+        std::lock_guard<std::mutex> lock(shard->mutex_);
+        shard->cv_.notify_all();
+      }
+      curl_multi_wakeup(shard->multi_handle_);
+      shard->worker_.join();
+    }
   }
 
   if (easy_handle_ != nullptr) {
     curl_easy_cleanup(reinterpret_cast<CURL*>(easy_handle_));
   }
 
-  if (multi_handle_ != nullptr) {
-    for (auto& request : ongoing_async_requests_) {
-      CURL* easy_handle = reinterpret_cast<CURL*>(request.first);
-      curl_multi_remove_handle(multi_handle_, easy_handle);
-      curl_easy_cleanup(easy_handle);
+  for (auto& shard : async_shards_) {
+    if (shard->multi_handle_ != nullptr) {
+      for (auto& request : shard->ongoing_async_requests_) {
+        CURL* easy_handle = reinterpret_cast<CURL*>(request.first);
+        curl_multi_remove_handle(shard->multi_handle_, easy_handle);
+        curl_easy_cleanup(easy_handle);
+      }
+      curl_multi_cleanup(shard->multi_handle_);
     }
-    curl_multi_cleanup(multi_handle_);
+  }
+
+  for (auto handle : easy_handle_pool_) {
+    curl_easy_cleanup(reinterpret_cast<CURL*>(handle));
   }
 }
 
@@ -1342,6 +1844,58 @@ InferenceServerHttpClient::UnregisterCudaSharedMemory(
   return Post(request_uri, request, headers, query_params, &response);
 }
 
+Error
+InferenceServerHttpClient::PrepareRequest(
+    std::unique_ptr<PreparedRequest>* prepared_request,
+    const InferOptions& options, const std::vector<InferInput*>& inputs,
+    const std::vector<const InferRequestedOutput*>& outputs,
+    const Headers& headers, const Parameters& query_params,
+    const CompressionType request_compression_algorithm,
+    const CompressionType response_compression_algorithm)
+{
+  std::unique_ptr<HttpPreparedRequest> request(
+      new HttpPreparedRequest(options.model_name_));
+  Error err = request->SetInputs(inputs);
+  if (!err.IsOk()) {
+    return err;
+  }
+
+  request->request_uri_ = url_ + "/v2/models/" + options.model_name_;
+  if (!options.model_version_.empty()) {
+    request->request_uri_ += "/versions/" + options.model_version_;
+  }
+  request->request_uri_ += "/infer";
+  if (!query_params.empty()) {
+    request->request_uri_ += "?" + GetQueryString(query_params);
+  }
+
+  request->outputs_empty_ = outputs.empty();
+  request->output_destinations_ = OutputDestinations(outputs);
+  triton::common::TritonJson::Value tensors_json(
+      triton::common::TritonJson::ValueType::OBJECT);
+  err = HttpInferRequest::PrepareRequestTensorsJson(
+      inputs, outputs, &tensors_json);
+  if (!err.IsOk()) {
+    return err;
+  }
+  triton::common::TritonJson::WriteBuffer tensors_buffer;
+  tensors_json.Write(&tensors_buffer);
+  // Skip the opening brace, the members are appended to the per-call ones.
+  // Nothing is kept for an empty object.
+  if (tensors_buffer.Size() > 2) {
+    request->tensors_json_.assign(
+        tensors_buffer.Base() + 1, tensors_buffer.Size() - 1);
+  }
+
+  request->header_list_ =
+      AppendInferHeaders(nullptr, headers, request_compression_algorithm);
+  request->request_compression_algorithm_ = request_compression_algorithm;
+  request->response_compression_algorithm_ = response_compression_algorithm;
+
+  prepared_request->reset(request.release());
+  return Error::Success;
+}
+
 Error
 InferenceServerHttpClient::Infer(
     InferResult** result, const InferOptions& options,
@@ -1377,6 +1931,43 @@ InferenceServerHttpClient::Infer(
     return err;
   }
 
+  return PerformSyncRequest(result, sync_request);
+}
+
+Error
+InferenceServerHttpClient::Infer(
+    InferResult** result, const PreparedRequest& prepared_request,
+    const InferOptions& options)
+{
+  const HttpPreparedRequest* http_prepared_request =
+      dynamic_cast<const HttpPreparedRequest*>(&prepared_request);
+  if (http_prepared_request == nullptr) {
+    return Error("the request was not prepared by an HTTP client");
+  }
+
+  std::shared_ptr<HttpInferRequest> sync_request(
+      new HttpInferRequest(nullptr /* callback */, verbose_));
+
+  sync_request->Timer().Reset();
+  sync_request->Timer().CaptureTimestamp(RequestTimers::Kind::REQUEST_START);
+
+  if (!CurlGlobal::Get().Status().IsOk()) {
+    return CurlGlobal::Get().Status();
+  }
+
+  Error err = PreRunProcessing(
+      easy_handle_, *http_prepared_request, options, sync_request);
+  if (!err.IsOk()) {
+    return err;
+  }
+
+  return PerformSyncRequest(result, sync_request);
+}
+
+Error
+InferenceServerHttpClient::PerformSyncRequest(
+    InferResult** result, std::shared_ptr<HttpInferRequest>& sync_request)
+{
   sync_request->Timer().CaptureTimestamp(RequestTimers::Kind::SEND_START);
 
   // Set SEND_END when content length is 0 (because
@@ -1403,7 +1994,7 @@ InferenceServerHttpClient::Infer(
 
   sync_request->Timer().CaptureTimestamp(RequestTimers::Kind::REQUEST_END);
 
-  err = UpdateInferStat(sync_request->Timer());
+  Error err = UpdateInferStat(sync_request->Timer());
   if (!err.IsOk()) {
     std::cerr << "Failed to update context stat: " << err << std::endl;
   }
@@ -1428,42 +2019,102 @@ InferenceServerHttpClient::AsyncInfer(
         "Callback function must be provided along with AsyncInfer() call.");
   }
 
-  std::shared_ptr<HttpInferRequest> async_request;
-  if (!multi_handle_) {
-    return Error("failed to start HTTP asynchronous client");
-  } else if (!worker_.joinable()) {
-    worker_ = std::thread(&InferenceServerHttpClient::AsyncTransfer, this);
-  }
-
   std::string request_uri(url_ + "/v2/models/" + options.model_name_);
   if (!options.model_version_.empty()) {
     request_uri = request_uri + "/versions/" + options.model_version_;
   }
   request_uri = request_uri + "/infer";
 
-  HttpInferRequest* raw_async_request =
-      new HttpInferRequest(std::move(callback), verbose_);
-  async_request.reset(raw_async_request);
+  std::shared_ptr<HttpInferRequest> async_request(
+      new HttpInferRequest(std::move(callback), verbose_));
 
   async_request->Timer().CaptureTimestamp(RequestTimers::Kind::REQUEST_START);
 
-  CURL* multi_easy_handle = curl_easy_init();
-  Error err = PreRunProcessing(
-      reinterpret_cast<void*>(multi_easy_handle), request_uri, options, inputs,
-      outputs, headers, query_params, request_compression_algorithm,
-      response_compression_algorithm, async_request);
+  return SubmitAsyncRequest(async_request, [&](void* multi_easy_handle) {
+    return PreRunProcessing(
+        multi_easy_handle, request_uri, options, inputs, outputs, headers,
+        query_params, request_compression_algorithm,
+        response_compression_algorithm, async_request);
+  });
+}
+
+Error
+InferenceServerHttpClient::AsyncInfer(
+    OnCompleteFn callback, const PreparedRequest& prepared_request,
+    const InferOptions& options)
+{
+  if (callback == nullptr) {
+    return Error(
+        "Callback function must be provided along with AsyncInfer() call.");
+  }
+  const HttpPreparedRequest* http_prepared_request =
+      dynamic_cast<const HttpPreparedRequest*>(&prepared_request);
+  if (http_prepared_request == nullptr) {
+    return Error("the request was not prepared by an HTTP client");
+  }
+
+  std::shared_ptr<HttpInferRequest> async_request(
+      new HttpInferRequest(std::move(callback), verbose_));
+
+  async_request->Timer().CaptureTimestamp(RequestTimers::Kind::REQUEST_START);
+
+  return SubmitAsyncRequest(async_request, [&](void* multi_easy_handle) {
+    return PreRunProcessing(
+        multi_easy_handle, *http_prepared_request, options, async_request);
+  });
+}
+
+Error
+InferenceServerHttpClient::CreateInferBatcher(
+    std::unique_ptr<InferBatcher>* batcher,
+    const InferBatcherOptions& batcher_options, const Headers& headers,
+    const CompressionType request_compression_algorithm,
+    const CompressionType response_compression_algorithm)
+{
+  return InferBatcher::Create(
+      batcher,
+      [this, headers, request_compression_algorithm,
+       response_compression_algorithm](
+          OnCompleteFn callback, const InferOptions& options,
+          const std::vector<InferInput*>& inputs,
+          const std::vector<const InferRequestedOutput*>& outputs) {
+        return AsyncInfer(
+            callback, options, inputs, outputs, headers, Parameters(),
+            request_compression_algorithm, response_compression_algorithm);
+      },
+      batcher_options);
+}
+
+Error
+InferenceServerHttpClient::SubmitAsyncRequest(
+    std::shared_ptr<HttpInferRequest>& async_request,
+    const std::function<Error(void*)>& prepare)
+{
+  AsyncShard* shard = NextAsyncShard();
+  if (!shard->multi_handle_) {
+    return Error("failed to start HTTP asynchronous client");
+  } else if (!shard->worker_.joinable()) {
+    shard->worker_ =
+        std::thread(&InferenceServerHttpClient::AsyncTransfer, this, shard);
+  }
+
+  CURL* multi_easy_handle = reinterpret_cast<CURL*>(AcquireEasyHandle());
+  if (multi_easy_handle == nullptr) {
+    return Error("failed to initialize HTTP asynchronous request");
+  }
+  Error err = prepare(reinterpret_cast<void*>(multi_easy_handle));
   if (!err.IsOk()) {
-    curl_easy_cleanup(multi_easy_handle);
+    ReleaseEasyHandle(multi_easy_handle);
     return err;
   }
 
   {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<std::mutex> lock(shard->mutex_);
 
-    auto insert_result = ongoing_async_requests_.emplace(std::make_pair(
+    auto insert_result = shard->ongoing_async_requests_.emplace(std::make_pair(
         reinterpret_cast<uintptr_t>(multi_easy_handle), async_request));
     if (!insert_result.second) {
-      curl_easy_cleanup(multi_easy_handle);
+      ReleaseEasyHandle(multi_easy_handle);
       return Error("Failed to insert new asynchronous request context.");
     }
 
@@ -1475,10 +2126,15 @@ InferenceServerHttpClient::AsyncInfer(
       async_request->Timer().CaptureTimestamp(RequestTimers::Kind::SEND_END);
     }
 
-    curl_multi_add_handle(multi_handle_, multi_easy_handle);
+    // The multi handle is only driven by the worker thread, which adds the
+    // new request to it.
+    shard->pending_async_handles_.push_back(
+        reinterpret_cast<void*>(multi_easy_handle));
+    shard->inflight_count_++;
   }
 
-  cv_.notify_all();
+  shard->cv_.notify_all();
+  curl_multi_wakeup(shard->multi_handle_);
   return Error::Success;
 }
 
@@ -1505,26 +2161,28 @@ InferenceServerHttpClient::InferMulti(
         "'outputs' must either contain 0/1 element or match size of 'inputs'");
   }
 
-  int64_t max_option_idx = options.size() - 1;
-  // value of '-1' means no output is specified
-  int64_t max_output_idx = outputs.size() - 1;
-  static std::vector<const InferRequestedOutput*> empty_outputs{};
-  for (int64_t i = 0; i < (int64_t)inputs.size(); ++i) {
-    const auto& request_options = options[std::min(max_option_idx, i)];
-    const auto& request_output = (max_output_idx == -1)
-                                     ? empty_outputs
-                                     : outputs[std::min(max_output_idx, i)];
+  if (inputs.empty()) {
+    return Error::Success;
+  }
 
-    results->emplace_back();
-    err = Infer(
-        &results->back(), request_options, inputs[i], request_output, headers,
-        query_params, request_compression_algorithm,
-        response_compression_algorithm);
-    if (!err.IsOk()) {
-      return err;
+  // Send all the requests at once and wait for the last of them to complete
+  std::promise<std::vector<InferResult*>> multi_results;
+  err = AsyncInferMulti(
+      [&multi_results](std::vector<InferResult*> async_results) {
+        multi_results.set_value(std::move(async_results));
+      },
+      options, inputs, outputs, headers, query_params,
+      request_compression_algorithm, response_compression_algorithm);
+  if (!err.IsOk()) {
+    return err;
+  }
+  for (auto result : multi_results.get_future().get()) {
+    results->emplace_back(result);
+    if (err.IsOk()) {
+      err = result->RequestStatus();
     }
   }
-  return Error::Success;
+  return err;
 }
 
 Error
@@ -1641,9 +2299,28 @@ InferenceServerHttpClient::InferResponseHeaderHandler(
 
     if (length_idx < byte_size) {
       std::string hdr(buf + length_idx + 1, byte_size - length_idx - 1);
-      request->infer_response_buffer_->reserve(std::stoi(hdr));
+      request->response_content_length_ = std::stoull(hdr);
+    }
+  }
+#ifdef TRITON_ENABLE_LZ4
+  else if (
+      request->accept_lz4_response_ &&
+      (strlen(kContentEncodingHTTPHeader) < byte_size) &&
+      !strncasecmp(
+          buf, kContentEncodingHTTPHeader,
+          strlen(kContentEncodingHTTPHeader))) {
+    std::string hdr(buf, byte_size);
+    if (hdr.find("lz4") != std::string::npos) {
+      std::unique_ptr<Lz4Decompressor> decompressor(new Lz4Decompressor());
+      Error err = decompressor->Init();
+      if (!err.IsOk()) {
+        std::cerr << "InferResponseHeaderHandler: " << err << std::endl;
+        return 0;
+      }
+      request->response_decompressor_ = std::move(decompressor);
     }
   }
+#endif  // TRITON_ENABLE_LZ4
 
   return byte_size;
 }
@@ -1656,11 +2333,28 @@ InferenceServerHttpClient::InferResponseHandler(
 
   if (request->Timer().Timestamp(RequestTimers::Kind::RECV_START) == 0) {
     request->Timer().CaptureTimestamp(RequestTimers::Kind::RECV_START);
+    // All the response headers are received before the body
+    request->ReserveResponseBuffer();
   }
 
   char* buf = reinterpret_cast<char*>(contents);
   size_t result_bytes = size * nmemb;
-  request->infer_response_buffer_->append(buf, result_bytes);
+#ifdef TRITON_ENABLE_LZ4
+  if (request->response_decompressor_ != nullptr) {
+    Error err = request->response_decompressor_->Decompress(
+        buf, result_bytes, [request](const char* data, size_t byte_size) {
+          request->AppendResponse(data, byte_size);
+        });
+    if (!err.IsOk()) {
+      std::cerr << "InferResponseHandler: " << err << std::endl;
+      return 0;
+    }
+  } else {
+    request->AppendResponse(buf, result_bytes);
+  }
+#else
+  request->AppendResponse(buf, result_bytes);
+#endif  // TRITON_ENABLE_LZ4
 
   // InferResponseHandler may be called multiple times so we overwrite
   // RECV_END so that we always have the time of the last.
@@ -1679,14 +2373,69 @@ InferenceServerHttpClient::PreRunProcessing(
     const CompressionType response_compression_algorithm,
     std::shared_ptr<HttpInferRequest>& http_request)
 {
-  CURL* curl = reinterpret_cast<CURL*>(vcurl);
-
   // Prepare the request object to provide the data for inference.
   Error err = http_request->InitializeRequest(options, inputs, outputs);
   if (!err.IsOk()) {
     return err;
   }
 
+  if (!query_params.empty()) {
+    request_uri = request_uri + "?" + GetQueryString(query_params);
+  }
+
+  struct curl_slist* list = nullptr;
+
+  std::string infer_hdr{std::string(kInferHeaderContentLengthHTTPHeader) +
+                        ": " + std::to_string(http_request->RequestJsonSize())};
+  list = curl_slist_append(list, infer_hdr.c_str());
+  list = AppendInferHeaders(list, headers, request_compression_algorithm);
+
+  // The list will be freed when the request is destructed
+  http_request->header_list_ = list;
+
+  return SetupInferRequest(
+      vcurl, request_uri, options, inputs, request_compression_algorithm,
+      response_compression_algorithm, list, http_request);
+}
+
+Error
+InferenceServerHttpClient::PreRunProcessing(
+    void* vcurl, const HttpPreparedRequest& prepared_request,
+    const InferOptions& options,
+    std::shared_ptr<HttpInferRequest>& http_request)
+{
+  Error err = prepared_request.CheckInputByteSizes();
+  if (!err.IsOk()) {
+    return err;
+  }
+  err = http_request->InitializeRequest(prepared_request, options);
+  if (!err.IsOk()) {
+    return err;
+  }
+
+  http_request->infer_header_ =
+      std::string(kInferHeaderContentLengthHTTPHeader) + ": " +
+      std::to_string(http_request->RequestJsonSize());
+  http_request->infer_header_node_.data = &http_request->infer_header_[0];
+  http_request->infer_header_node_.next = prepared_request.header_list_;
+
+  return SetupInferRequest(
+      vcurl, prepared_request.request_uri_, options, prepared_request.inputs_,
+      prepared_request.request_compression_algorithm_,
+      prepared_request.response_compression_algorithm_,
+      &http_request->infer_header_node_, http_request);
+}
+
+Error
+InferenceServerHttpClient::SetupInferRequest(
+    void* vcurl, const std::string& request_uri, const InferOptions& options,
+    const std::vector<InferInput*>& inputs,
+    const CompressionType request_compression_algorithm,
+    const CompressionType response_compression_algorithm,
+    void* header_list, std::shared_ptr<HttpInferRequest>& http_request)
+{
+  CURL* curl = reinterpret_cast<CURL*>(vcurl);
+
   // Add the buffers holding input tensor data
   for (const auto this_input : inputs) {
     if (!this_input->IsSharedMemory()) {
@@ -1703,25 +2452,25 @@ InferenceServerHttpClient::PreRunProcessing(
     }
   }
 
-  // Compress data if requested
-  switch (request_compression_algorithm) {
-    case CompressionType::NONE:
-      break;
-    case CompressionType::DEFLATE:
-    case CompressionType::GZIP:
-      http_request->CompressInput(request_compression_algorithm);
-      break;
+  // Compress data while it is sent if requested
+  if (request_compression_algorithm != CompressionType::NONE) {
+    Error err = http_request->CompressInput(request_compression_algorithm);
+    if (!err.IsOk()) {
+      return err;
+    }
   }
 
   // Prepare curl
-  if (!query_params.empty()) {
-    request_uri = request_uri + "?" + GetQueryString(query_params);
-  }
-
   curl_easy_setopt(curl, CURLOPT_URL, request_uri.c_str());
   curl_easy_setopt(curl, CURLOPT_USERAGENT, "libcurl-agent/1.0");
   curl_easy_setopt(curl, CURLOPT_POST, 1L);
   curl_easy_setopt(curl, CURLOPT_TCP_NODELAY, 1L);
+  SetTransportCurlOptions(curl, url_, transport_options_);
+  if (transport_options_.protocol == HttpTransportOptions::PROTOCOL::HTTP2) {
+    // Wait for an existing connection to confirm multiplexing instead of
+    // opening a new connection per concurrent request.
+    curl_easy_setopt(curl, CURLOPT_PIPEWAIT, 1L);
+  }
   if (options.client_timeout_ != 0) {
     uint64_t timeout_ms = (options.client_timeout_ / 1000);
     curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, timeout_ms);
@@ -1747,40 +2496,25 @@ InferenceServerHttpClient::PreRunProcessing(
   curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, InferResponseHandler);
   curl_easy_setopt(curl, CURLOPT_WRITEDATA, http_request.get());
 
-  const curl_off_t post_byte_size = http_request->total_input_byte_size_;
+  // The size of compressed data is unknown until it is all produced, so
+  // it is sent with chunked transfer encoding.
+  const curl_off_t post_byte_size =
+      http_request->IsInputCompressed()
+          ? -1
+          : static_cast<curl_off_t>(http_request->total_input_byte_size_);
   curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE_LARGE, post_byte_size);
 
-  err = SetSSLCurlOptions(&curl, ssl_options_);
+  Error err = SetSSLCurlOptions(&curl, ssl_options_);
   if (!err.IsOk()) {
     return err;
   }
 
-  struct curl_slist* list = nullptr;
-
-  std::string infer_hdr{std::string(kInferHeaderContentLengthHTTPHeader) +
-                        ": " +
-                        std::to_string(http_request->request_json_.Size())};
-  list = curl_slist_append(list, infer_hdr.c_str());
-  list = curl_slist_append(list, "Expect:");
-  list = curl_slist_append(list, "Content-Type: application/octet-stream");
-  for (const auto& pr : headers) {
-    std::string hdr = pr.first + ": " + pr.second;
-    list = curl_slist_append(list, hdr.c_str());
-  }
-
-  // Compress data if requested
-  switch (request_compression_algorithm) {
-    case CompressionType::NONE:
-      break;
-    case CompressionType::DEFLATE:
-      list = curl_slist_append(list, "Content-Encoding: deflate");
-      break;
-    case CompressionType::GZIP:
-      list = curl_slist_append(list, "Content-Encoding: gzip");
-      break;
-  }
+  // libcurl decodes the response, except for lz4 which it doesn't know
+  // and is decoded as it is received.
+  long content_decoding = 1L;
   switch (response_compression_algorithm) {
     case CompressionType::NONE:
+      curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, nullptr);
       break;
     case CompressionType::DEFLATE:
       curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, "deflate");
@@ -1788,48 +2522,94 @@ InferenceServerHttpClient::PreRunProcessing(
     case CompressionType::GZIP:
       curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, "gzip");
       break;
+    case CompressionType::ZSTD:
+      if ((curl_version_info(CURLVERSION_NOW)->features & CURL_VERSION_ZSTD) ==
+          0) {
+        return Error("libcurl is built without zstd response decoding");
+      }
+      curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, "zstd");
+      break;
+    case CompressionType::LZ4:
+#ifdef TRITON_ENABLE_LZ4
+      curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, "lz4");
+      content_decoding = 0L;
+      http_request->accept_lz4_response_ = true;
+#else
+      return Error("lz4 compression is not enabled in this build");
+#endif  // TRITON_ENABLE_LZ4
+      break;
   }
-  curl_easy_setopt(curl, CURLOPT_HTTPHEADER, list);
-
-  // The list will be freed when the request is destructed
-  http_request->header_list_ = list;
+  curl_easy_setopt(curl, CURLOPT_HTTP_CONTENT_DECODING, content_decoding);
+  curl_easy_setopt(curl, CURLOPT_HTTPHEADER, header_list);
 
   if (verbose_) {
-    std::cout << "inference request: " << http_request->request_json_.Contents()
+    std::cout << "inference request: " << http_request->RequestJson()
               << std::endl;
   }
 
   return Error::Success;
 }
 
+InferenceServerHttpClient::AsyncShard*
+InferenceServerHttpClient::NextAsyncShard()
+{
+  if (async_shards_.size() == 1) {
+    return async_shards_.front().get();
+  }
+
+  switch (async_options_.placement) {
+    case HttpAsyncOptions::PLACEMENT::LEAST_INFLIGHT: {
+      AsyncShard* least_loaded = async_shards_.front().get();
+      for (auto& shard : async_shards_) {
+        if (shard->inflight_count_ < least_loaded->inflight_count_) {
+          least_loaded = shard.get();
+        }
+      }
+      return least_loaded;
+    }
+    case HttpAsyncOptions::PLACEMENT::ROUND_ROBIN:
+    default:
+      return async_shards_[next_async_shard_++ % async_shards_.size()].get();
+  }
+}
+
 void
-InferenceServerHttpClient::AsyncTransfer()
+InferenceServerHttpClient::AsyncTransfer(AsyncShard* shard)
 {
+  CURLM* multi_handle = reinterpret_cast<CURLM*>(shard->multi_handle_);
   int place_holder = 0;
   CURLMsg* msg = nullptr;
   do {
     std::vector<std::shared_ptr<HttpInferRequest>> request_list;
+    std::vector<void*> new_handles;
 
     // sleep if no work is available
-    std::unique_lock<std::mutex> lock(mutex_);
-    cv_.wait(lock, [this] {
+    std::unique_lock<std::mutex> lock(shard->mutex_);
+    shard->cv_.wait(lock, [this, shard] {
       if (this->exiting_) {
         return true;
       }
       // wake up if an async request has been generated
-      return !this->ongoing_async_requests_.empty();
+      return !shard->ongoing_async_requests_.empty();
     });
+    new_handles.swap(shard->pending_async_handles_);
+    lock.unlock();
+
+    for (auto handle : new_handles) {
+      curl_multi_add_handle(multi_handle, reinterpret_cast<CURL*>(handle));
+    }
+    curl_multi_perform(multi_handle, &place_holder);
 
-    curl_multi_perform(multi_handle_, &place_holder);
-    while ((msg = curl_multi_info_read(multi_handle_, &place_holder))) {
+    lock.lock();
+    while ((msg = curl_multi_info_read(multi_handle, &place_holder))) {
       uintptr_t identifier = reinterpret_cast<uintptr_t>(msg->easy_handle);
-      auto itr = ongoing_async_requests_.find(identifier);
+      auto itr = shard->ongoing_async_requests_.find(identifier);
       // This shouldn't happen
-      if (itr == ongoing_async_requests_.end()) {
+      if (itr == shard->ongoing_async_requests_.end()) {
         std::cerr << "Unexpected error: received completed request that is not "
                      "in the list of asynchronous requests"
                   << std::endl;
-        curl_multi_remove_handle(multi_handle_, msg->easy_handle);
+        curl_multi_remove_handle(multi_handle, msg->easy_handle);
         curl_easy_cleanup(msg->easy_handle);
         continue;
       }
@@ -1842,9 +2622,10 @@ InferenceServerHttpClient::AsyncTransfer()
       }
 
       request_list.emplace_back(itr->second);
-      ongoing_async_requests_.erase(itr);
-      curl_multi_remove_handle(multi_handle_, msg->easy_handle);
-      curl_easy_cleanup(msg->easy_handle);
+      shard->ongoing_async_requests_.erase(itr);
+      shard->inflight_count_--;
+      curl_multi_remove_handle(multi_handle, msg->easy_handle);
+      ReleaseEasyHandle(msg->easy_handle);
 
       std::shared_ptr<HttpInferRequest> async_request = request_list.back();
       async_request->http_code_ = http_code;
@@ -1862,16 +2643,60 @@ InferenceServerHttpClient::AsyncTransfer()
         }
       }
     }
+    const bool in_flight = !shard->ongoing_async_requests_.empty();
     lock.unlock();
 
     for (auto& this_request : request_list) {
       InferResult* result;
       InferResultHttp::Create(&result, this_request);
-      this_request->callback_(result);
+      ExecuteCallback(this_request, result);
+    }
+
+    // Sleep until there is activity on one of the transfers, a curl timer
+    // expires or AsyncInfer() / the destructor wakes the thread up, instead
+    // of spinning on curl_multi_perform() while waiting for the server.
+    if (in_flight && !exiting_) {
+      int numfds = 0;
+      curl_multi_poll(multi_handle, nullptr, 0, kAsyncPollTimeoutMs, &numfds);
     }
   } while (!exiting_);
 }
 
+void*
+InferenceServerHttpClient::AcquireEasyHandle()
+{
+  {
+    std::lock_guard<std::mutex> lock(easy_handle_pool_mutex_);
+    if (!easy_handle_pool_.empty()) {
+      void* handle = easy_handle_pool_.back();
+      easy_handle_pool_.pop_back();
+      handle_pool_hit_count_.fetch_add(1, std::memory_order_relaxed);
+      return handle;
+    }
+  }
+  handle_pool_miss_count_.fetch_add(1, std::memory_order_relaxed);
+
+  return reinterpret_cast<void*>(curl_easy_init());
+}
+
+void
+InferenceServerHttpClient::ReleaseEasyHandle(void* handle)
+{
+  CURL* curl = reinterpret_cast<CURL*>(handle);
+  // Drop all the options set for the previous request so that they are not
+  // carried over to the next one. Live connections and caches are kept.
+  curl_easy_reset(curl);
+  {
+    std::lock_guard<std::mutex> lock(easy_handle_pool_mutex_);
+    if (easy_handle_pool_.size() < async_options_.easy_handle_pool_size) {
+      easy_handle_pool_.push_back(handle);
+      return;
+    }
+  }
+
+  curl_easy_cleanup(curl);
+}
+
 size_t
 InferenceServerHttpClient::ResponseHandler(
     void* contents, size_t size, size_t nmemb, void* userp)
@@ -1926,6 +2751,7 @@ InferenceServerHttpClient::Get(
   curl_easy_setopt(curl, CURLOPT_URL, request_uri.c_str());
   curl_easy_setopt(curl, CURLOPT_USERAGENT, "libcurl-agent/1.0");
   curl_easy_setopt(curl, CURLOPT_TCP_NODELAY, 1L);
+  SetTransportCurlOptions(curl, url_, transport_options_);
   if (verbose_) {
     curl_easy_setopt(curl, CURLOPT_VERBOSE, 1L);
   }
@@ -2002,6 +2828,7 @@ InferenceServerHttpClient::Post(
   curl_easy_setopt(curl, CURLOPT_URL, request_uri.c_str());
   curl_easy_setopt(curl, CURLOPT_USERAGENT, "libcurl-agent/1.0");
   curl_easy_setopt(curl, CURLOPT_TCP_NODELAY, 1L);
+  SetTransportCurlOptions(curl, url_, transport_options_);
   curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, request.size());
   curl_easy_setopt(curl, CURLOPT_POSTFIELDS, request.c_str());
   if (verbose_) {
@@ -27,6 +27,8 @@
 
 /// \file
 
+#include <atomic>
+#include <functional>
 #include <map>
 #include <memory>
 #include "common.h"
@@ -35,6 +37,7 @@
 namespace triton { namespace client {
 
 class HttpInferRequest;
+class HttpPreparedRequest;
 
 /// The key-value map type to be included in the request
 /// as custom headers.
@@ -86,6 +89,66 @@ struct HttpSslOptions {
   std::string key;
 };
 
+// The options for the asynchronous inference engine of the HTTP client.
+struct HttpAsyncOptions {
+  enum PLACEMENT { ROUND_ROBIN = 0, LEAST_INFLIGHT = 1 };
+  explicit HttpAsyncOptions()
+      : easy_handle_pool_size(16), worker_count(1),
+        placement(PLACEMENT::ROUND_ROBIN)
+  {
+  }
+  // The maximum number of idle curl easy handles kept for reuse by
+  // AsyncInfer(). Once a request completes its handle is reset and returned
+  // to the pool instead of being destroyed, which avoids the cost of
+  // creating a handle per request and keeps curl's per-handle caches warm.
+  // A value of 0 disables pooling. Default value is 16.
+  size_t easy_handle_pool_size;
+  // The number of worker threads that perform the asynchronous requests.
+  // Each worker owns a separate set of connections and runs the callbacks of
+  // its requests, so with more than one worker the callbacks may be invoked
+  // concurrently from different threads. Default value is 1.
+  size_t worker_count;
+  // How an asynchronous request is assigned to a worker: in turn
+  // (ROUND_ROBIN) or to the worker with the fewest requests in flight
+  // (LEAST_INFLIGHT). Default value is ROUND_ROBIN.
+  PLACEMENT placement;
+};
+
+// The options for the HTTP transport used to reach the server.
+struct HttpTransportOptions {
+  enum PROTOCOL { HTTP1 = 0, HTTP2 = 1 };
+  explicit HttpTransportOptions()
+      : protocol(PROTOCOL::HTTP1), max_connections(0),
+        max_concurrent_streams(100), unix_socket_path("")
+  {
+  }
+  // The HTTP protocol version used for the requests. With HTTP2, 'http://'
+  // urls use HTTP/2 with prior knowledge (h2c) and 'https://' urls negotiate
+  // HTTP/2 with ALPN, falling back to HTTP/1.1 if the server doesn't support
+  // it. Asynchronous requests are then multiplexed as streams over a small
+  // number of connections instead of using one connection per request.
+  // Default value is HTTP1.
+  PROTOCOL protocol;
+  // The maximum number of connections each asynchronous worker (see
+  // HttpAsyncOptions::worker_count) may open to the server. Requests that
+  // can't be assigned to a connection are queued until one becomes
+  // available. A value of 0 means no limit. See here for more details:
+  // https://curl.se/libcurl/c/CURLMOPT_MAX_HOST_CONNECTIONS.html
+  long max_connections;
+  // The maximum number of concurrent streams per connection, only used with
+  // HTTP2. Default value is 100. See here for more details:
+  // https://curl.se/libcurl/c/CURLMOPT_MAX_CONCURRENT_STREAMS.html
+  long max_concurrent_streams;
+  // The path of a Unix domain socket that all the requests are sent over
+  // instead of TCP, for a server running on the same host. The host of the
+  // server url is then only used for the 'Host' header. A server url with
+  // the 'unix://' scheme, for example 'unix:///tmp/triton.sock', sets this
+  // to the path after the scheme. Default value is empty, which means TCP
+  // is used. See here for more details:
+  // https://curl.se/libcurl/c/CURLOPT_UNIX_SOCKET_PATH.html
+  std::string unix_socket_path;
+};
+
 //==============================================================================
 /// An InferenceServerHttpClient object is used to perform any kind of
 /// communication with the InferenceServer using HTTP protocol. None
@@ -105,7 +168,14 @@ struct HttpSslOptions {
 ///
 class InferenceServerHttpClient : public InferenceServerClient {
  public:
-  enum class CompressionType { NONE, DEFLATE, GZIP };
+  /// The compression algorithms for the request and response bodies. ZSTD
+  /// and LZ4 are only available if the library is built with
+  /// TRITON_ENABLE_ZSTD and TRITON_ENABLE_LZ4 respectively. A compressed
+  /// request body is compressed while it is sent, so its size isn't known
+  /// up front: it is sent without a Content-Length header, using chunked
+  /// transfer encoding. Servers and proxies between the client and the
+  /// server must accept chunked requests.
+  enum class CompressionType { NONE, DEFLATE, GZIP, ZSTD, LZ4 };
   ~InferenceServerHttpClient();
 
   /// Generate a request body for inference using the supplied 'inputs' and
@@ -141,7 +211,8 @@ class InferenceServerHttpClient : public InferenceServerClient {
   /// \param client Returns a new InferenceServerHttpClient object.
   /// \param server_url The inference server name, port, optional
   /// scheme and optional base path in the following format:
-  /// <scheme://>host:port/<base-path>.
+  /// <scheme://>host:port/<base-path>. The server may also be reached
+  /// over a Unix domain socket with 'unix://<socket-path>'.
   /// \param verbose If true generate verbose output when contacting
   /// the inference server.
   /// \param ssl_options Specifies the settings for configuring
@@ -150,11 +221,19 @@ class InferenceServerHttpClient : public InferenceServerClient {
   /// The use of SSL/TLS depends entirely on the server endpoint.
   /// These options will be ignored if the server_url does not
   /// expose `https://` scheme.
+  /// \param async_options Specifies the settings of the engine that
+  /// performs asynchronous requests, such as the size of the pool of
+  /// reusable transfer handles.
+  /// \param transport_options Specifies the HTTP protocol version, the
+  /// connection limits and the Unix domain socket used to reach the
+  /// server.
   /// \return Error object indicating success or failure.
   static Error Create(
       std::unique_ptr<InferenceServerHttpClient>* client,
       const std::string& server_url, bool verbose = false,
-      const HttpSslOptions& ssl_options = HttpSslOptions());
+      const HttpSslOptions& ssl_options = HttpSslOptions(),
+      const HttpAsyncOptions& async_options = HttpAsyncOptions(),
+      const HttpTransportOptions& transport_options = HttpTransportOptions());
 
   /// Contact the inference server and get its liveness.
   /// \param live Returns whether the server is live or not.
@@ -409,12 +488,13 @@ class InferenceServerHttpClient : public InferenceServerClient {
   /// included with URL query.
   /// \param request_compression_algorithm Optional HTTP compression algorithm
   /// to use for the request body on client side. Currently supports DEFLATE,
-  /// GZIP and NONE. By default, no compression is used.
+  /// GZIP, ZSTD, LZ4 and NONE. The request body is compressed while it is
+  /// sent. By default, no compression is used.
   /// \param response_compression_algorithm Optional HTTP compression algorithm
   /// to request for the response body. Note that the response may not be
   /// compressed if the server does not support the specified algorithm.
-  /// Currently supports DEFLATE, GZIP and NONE. By default, no compression
-  /// is used.
+  /// Currently supports DEFLATE, GZIP, ZSTD, LZ4 and NONE. By default, no
+  /// compression is used.
   /// \return Error object indicating success or failure of the
   /// request.
   Error Infer(
@@ -453,12 +533,13 @@ class InferenceServerHttpClient : public InferenceServerClient {
   /// included with URL query.
   /// \param request_compression_algorithm Optional HTTP compression algorithm
   /// to use for the request body on client side. Currently supports DEFLATE,
-  /// GZIP and NONE. By default, no compression is used.
+  /// GZIP, ZSTD, LZ4 and NONE. The request body is compressed while it is
+  /// sent. By default, no compression is used.
   /// \param response_compression_algorithm Optional HTTP compression algorithm
   /// to request for the response body. Note that the response may not be
   /// compressed if the server does not support the specified algorithm.
-  /// Currently supports DEFLATE, GZIP and NONE. By default, no compression
-  /// is used.
+  /// Currently supports DEFLATE, GZIP, ZSTD, LZ4 and NONE. By default, no
+  /// compression is used.
   /// \return Error object indicating success
   /// or failure of the request.
   Error AsyncInfer(
@@ -473,8 +554,93 @@ class InferenceServerHttpClient : public InferenceServerClient {
       const CompressionType response_compression_algorithm =
           CompressionType::NONE);
 
-  /// Run multiple synchronous inferences on server.
-  /// \param results Returns the results of the inferences.
+  /// Prepare an inference request to be run any number of times with the
+  /// Infer() and AsyncInfer() functions taking a PreparedRequest. The
+  /// model, the inputs metadata, the requested outputs, the headers, the
+  /// query parameters and the compression algorithms are serialized once.
+  /// The 'inputs' objects are kept by the prepared request and their data
+  /// is read on each run, so the data can be changed between runs but not
+  /// the byte size of the inputs nor the other properties of the tensors.
+  /// \param prepared_request Returns the prepared request.
+  /// \param options The options for inference request, only the model name
+  /// and version are used.
+  /// \param inputs The vector of InferInput describing the model inputs.
+  /// \param outputs Optional vector of InferRequestedOutput describing how
+  /// the output must be returned. If not provided then all the outputs in the
+  /// model config will be returned as default settings.
+  /// \param headers Optional map specifying additional HTTP headers to include
+  /// in request.
+  /// \param query_params Optional map specifying parameters that must be
+  /// included with URL query.
+  /// \param request_compression_algorithm Optional HTTP compression algorithm
+  /// to use for the request body on client side. Currently supports DEFLATE,
+  /// GZIP, ZSTD, LZ4 and NONE. The request body is compressed while it is
+  /// sent. By default, no compression is used.
+  /// \param response_compression_algorithm Optional HTTP compression algorithm
+  /// to request for the response body. By default, no compression is used.
+  /// \return Error object indicating success or failure.
+  Error PrepareRequest(
+      std::unique_ptr<PreparedRequest>* prepared_request,
+      const InferOptions& options, const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs =
+          std::vector<const InferRequestedOutput*>(),
+      const Headers& headers = Headers(),
+      const Parameters& query_params = Parameters(),
+      const CompressionType request_compression_algorithm =
+          CompressionType::NONE,
+      const CompressionType response_compression_algorithm =
+          CompressionType::NONE);
+
+  /// Run synchronous inference on server using a prepared request.
+  /// \param result Returns the result of inference.
+  /// \param prepared_request The request prepared by this client.
+  /// \param options The options for inference request. The model name and
+  /// version are ignored in favor of the ones of the prepared request.
+  /// \return Error object indicating success or failure of the
+  /// request.
+  Error Infer(
+      InferResult** result, const PreparedRequest& prepared_request,
+      const InferOptions& options);
+
+  /// Run asynchronous inference on server using a prepared request. The
+  /// prepared request and the data of its inputs must remain valid until
+  /// 'callback' is invoked.
+  /// \param callback The callback function to be invoked on request completion.
+  /// \param prepared_request The request prepared by this client.
+  /// \param options The options for inference request. The model name and
+  /// version are ignored in favor of the ones of the prepared request.
+  /// \return Error object indicating success or failure of the request.
+  Error AsyncInfer(
+      OnCompleteFn callback, const PreparedRequest& prepared_request,
+      const InferOptions& options);
+
+  /// Create a batcher that coalesces the asynchronous inferences run
+  /// through it into batched requests sent by this client. See
+  /// InferBatcher. The batcher must be destroyed before the client.
+  /// \param batcher Returns a new InferBatcher object.
+  /// \param batcher_options The options of the batcher.
+  /// \param headers Optional map specifying additional HTTP headers to
+  /// include in the batched requests.
+  /// \param request_compression_algorithm Optional HTTP compression
+  /// algorithm to use for the body of the batched requests.
+  /// \param response_compression_algorithm Optional HTTP compression
+  /// algorithm to request for the response body of the batched requests.
+  /// \return Error object indicating success or failure.
+  Error CreateInferBatcher(
+      std::unique_ptr<InferBatcher>* batcher,
+      const InferBatcherOptions& batcher_options = InferBatcherOptions(),
+      const Headers& headers = Headers(),
+      const CompressionType request_compression_algorithm =
+          CompressionType::NONE,
+      const CompressionType response_compression_algorithm =
+          CompressionType::NONE);
+
+  /// Run multiple synchronous inferences on server. All the requests are
+  /// sent concurrently through the asynchronous requests machinery and the
+  /// function returns once all of them are completed. Hence it must not be
+  /// called from the callback of an asynchronous request.
+  /// \param results Returns the results of the inferences, in the same
+  /// order as the requests.
   /// \param options The options for each inference request, one set of
   /// options may be provided and it will be used for all inference requests.
   /// \param inputs The vector of InferInput objects describing the model inputs
@@ -489,14 +655,15 @@ class InferenceServerHttpClient : public InferenceServerClient {
   /// included with URL query.
   /// \param request_compression_algorithm Optional HTTP compression algorithm
   /// to use for the request body on client side. Currently supports DEFLATE,
-  /// GZIP and NONE. By default, no compression is used.
+  /// GZIP, ZSTD, LZ4 and NONE. The request body is compressed while it is
+  /// sent. By default, no compression is used.
   /// \param response_compression_algorithm Optional HTTP compression algorithm
   /// to request for the response body. Note that the response may not be
   /// compressed if the server does not support the specified algorithm.
-  /// Currently supports DEFLATE, GZIP and NONE. By default, no compression
-  /// is used.
+  /// Currently supports DEFLATE, GZIP, ZSTD, LZ4 and NONE. By default, no
+  /// compression is used.
   /// \return Error object indicating success or failure of the
-  /// request.
+  /// requests, the error of the first failed request if any.
   Error InferMulti(
       std::vector<InferResult*>* results,
       const std::vector<InferOptions>& options,
@@ -538,12 +705,13 @@ class InferenceServerHttpClient : public InferenceServerClient {
   /// included with URL query.
   /// \param request_compression_algorithm Optional HTTP compression algorithm
   /// to use for the request body on client side. Currently supports DEFLATE,
-  /// GZIP and NONE. By default, no compression is used.
+  /// GZIP, ZSTD, LZ4 and NONE. The request body is compressed while it is
+  /// sent. By default, no compression is used.
   /// \param response_compression_algorithm Optional HTTP compression algorithm
   /// to request for the response body. Note that the response may not be
   /// compressed if the server does not support the specified algorithm.
-  /// Currently supports DEFLATE, GZIP and NONE. By default, no compression
-  /// is used.
+  /// Currently supports DEFLATE, GZIP, ZSTD, LZ4 and NONE. By default, no
+  /// compression is used.
   /// \return Error object indicating success
   /// or failure of the request.
   Error AsyncInferMulti(
@@ -560,7 +728,9 @@ class InferenceServerHttpClient : public InferenceServerClient {
 
  private:
   InferenceServerHttpClient(
-      const std::string& url, bool verbose, const HttpSslOptions& ssl_options);
+      const std::string& url, bool verbose, const HttpSslOptions& ssl_options,
+      const HttpAsyncOptions& async_options,
+      const HttpTransportOptions& transport_options);
 
   Error PreRunProcessing(
       void* curl, std::string& request_uri, const InferOptions& options,
@@ -570,7 +740,34 @@ class InferenceServerHttpClient : public InferenceServerClient {
       const CompressionType request_compression_algorithm,
       const CompressionType response_compression_algorithm,
       std::shared_ptr<HttpInferRequest>& request);
-  void AsyncTransfer();
+  Error PreRunProcessing(
+      void* curl, const HttpPreparedRequest& prepared_request,
+      const InferOptions& options, std::shared_ptr<HttpInferRequest>& request);
+  // Set up 'curl' to send 'request' along with the data of 'inputs'.
+  Error SetupInferRequest(
+      void* curl, const std::string& request_uri, const InferOptions& options,
+      const std::vector<InferInput*>& inputs,
+      const CompressionType request_compression_algorithm,
+      const CompressionType response_compression_algorithm,
+      void* header_list, std::shared_ptr<HttpInferRequest>& request);
+  // Perform the synchronous request set up on 'easy_handle_'.
+  Error PerformSyncRequest(
+      InferResult** result, std::shared_ptr<HttpInferRequest>& request);
+  // Hand 'request' to an asynchronous worker once 'prepare' has set up the
+  // easy handle to perform it.
+  Error SubmitAsyncRequest(
+      std::shared_ptr<HttpInferRequest>& request,
+      const std::function<Error(void*)>& prepare);
+  struct AsyncShard;
+  // Select the shard that will perform the next asynchronous request.
+  AsyncShard* NextAsyncShard();
+  void AsyncTransfer(AsyncShard* shard);
+  // Get a curl easy handle for an asynchronous request, reusing a pooled
+  // handle if available. Returns nullptr if a handle can't be created.
+  void* AcquireEasyHandle();
+  // Return the easy handle of a finished asynchronous request to the pool,
+  // or destroy it if the pool is full.
+  void ReleaseEasyHandle(void* handle);
   Error Get(
       std::string& request_uri, const Headers& headers,
       const Parameters& query_params, std::string* response,
@@ -593,15 +790,41 @@ class InferenceServerHttpClient : public InferenceServerClient {
   const std::string url_;
   // The options for authorizing and authenticating SSL/TLS connections
   HttpSslOptions ssl_options_;
+  // The options for the asynchronous inference engine
+  HttpAsyncOptions async_options_;
+  // The options for the HTTP transport
+  HttpTransportOptions transport_options_;
 
   using AsyncReqMap = std::map<uintptr_t, std::shared_ptr<HttpInferRequest>>;
+  // A worker thread and the state it uses to perform a share of the
+  // asynchronous requests.
+  struct AsyncShard {
+    AsyncShard() : multi_handle_(nullptr), inflight_count_(0) {}
+    // curl multi handle for processing asynchronous requests, only driven
+    // by 'worker_'
+    void* multi_handle_;
+    std::thread worker_;
+    // Protects 'ongoing_async_requests_' and 'pending_async_handles_'
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    // map to record ongoing asynchronous requests with pointer to easy handle
+    // or tag id as key
+    AsyncReqMap ongoing_async_requests_;
+    // easy handles of the asynchronous requests that are yet to be added to
+    // 'multi_handle_' by the worker thread
+    std::vector<void*> pending_async_handles_;
+    // Number of requests assigned to the shard that have not completed
+    std::atomic<size_t> inflight_count_;
+  };
+
   // curl easy handle shared for all synchronous requests
   void* easy_handle_;
-  // curl multi handle for processing asynchronous requests
-  void* multi_handle_;
-  // map to record ongoing asynchronous requests with pointer to easy handle
-  // or tag id as key
-  AsyncReqMap ongoing_async_requests_;
+  // The shards performing asynchronous requests
+  std::vector<std::unique_ptr<AsyncShard>> async_shards_;
+  std::atomic<size_t> next_async_shard_;
+  // Idle curl easy handles available for reuse by asynchronous requests
+  std::vector<void*> easy_handle_pool_;
+  std::mutex easy_handle_pool_mutex_;
 };
 
 }}  // namespace triton::client
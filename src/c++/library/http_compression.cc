@@ -0,0 +1,336 @@
+// Copyright (c) 2026, NVIDIA CORPORATION. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#include "http_compression.h"
+
+#include <zlib.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#ifdef TRITON_ENABLE_ZSTD
+#include <zstd.h>
+#endif  // TRITON_ENABLE_ZSTD
+#ifdef TRITON_ENABLE_LZ4
+#include <lz4frame.h>
+#endif  // TRITON_ENABLE_LZ4
+
+namespace triton { namespace client {
+
+namespace {
+
+class ZlibCompressor : public RequestCompressor {
+ public:
+  ZlibCompressor() : initialized_(false) {}
+  ~ZlibCompressor();
+
+  Error Init(const InferenceServerHttpClient::CompressionType type);
+  Error Compress(
+      std::deque<std::pair<uint8_t*, size_t>>* source, uint8_t* buf,
+      size_t size, size_t* output_bytes) override;
+
+ private:
+  z_stream stream_;
+  bool initialized_;
+};
+
+ZlibCompressor::~ZlibCompressor()
+{
+  if (initialized_) {
+    deflateEnd(&stream_);
+  }
+}
+
+Error
+ZlibCompressor::Init(const InferenceServerHttpClient::CompressionType type)
+{
+  stream_.zalloc = Z_NULL;
+  stream_.zfree = Z_NULL;
+  stream_.opaque = Z_NULL;
+  if (type == InferenceServerHttpClient::CompressionType::GZIP) {
+    if (deflateInit2(
+            &stream_, Z_DEFAULT_COMPRESSION /* level */,
+            Z_DEFLATED /* method */, 15 | 16 /* windowBits */,
+            8 /* memLevel */, Z_DEFAULT_STRATEGY /* strategy */) != Z_OK) {
+      return Error("failed to initialize state for gzip data compression");
+    }
+  } else {
+    if (deflateInit(&stream_, Z_DEFAULT_COMPRESSION /* level */) != Z_OK) {
+      return Error("failed to initialize state for deflate data compression");
+    }
+  }
+  initialized_ = true;
+  return Error::Success;
+}
+
+Error
+ZlibCompressor::Compress(
+    std::deque<std::pair<uint8_t*, size_t>>* source, uint8_t* buf,
+    size_t size, size_t* output_bytes)
+{
+  stream_.next_out = reinterpret_cast<unsigned char*>(buf);
+  stream_.avail_out = size;
+  while ((stream_.avail_out > 0) && !finished_) {
+    DropConsumed(source);
+    if (!source->empty()) {
+      stream_.next_in = reinterpret_cast<unsigned char*>(source->front().first);
+      stream_.avail_in = source->front().second;
+      if (deflate(&stream_, Z_NO_FLUSH) == Z_STREAM_ERROR) {
+        return Error(
+            "encountered inconsistent stream state during compression");
+      }
+      Consume(source, source->front().second - stream_.avail_in);
+    } else {
+      stream_.next_in = Z_NULL;
+      stream_.avail_in = 0;
+      const auto ret = deflate(&stream_, Z_FINISH);
+      if (ret == Z_STREAM_END) {
+        finished_ = true;
+      } else if (ret == Z_STREAM_ERROR) {
+        return Error(
+            "encountered inconsistent stream state during compression");
+      }
+    }
+  }
+  *output_bytes = size - stream_.avail_out;
+  return Error::Success;
+}
+
+#ifdef TRITON_ENABLE_ZSTD
+class ZstdCompressor : public RequestCompressor {
+ public:
+  ZstdCompressor() : cctx_(nullptr) {}
+  ~ZstdCompressor();
+
+  Error Init();
+  Error Compress(
+      std::deque<std::pair<uint8_t*, size_t>>* source, uint8_t* buf,
+      size_t size, size_t* output_bytes) override;
+
+ private:
+  ZSTD_CCtx* cctx_;
+};
+
+ZstdCompressor::~ZstdCompressor()
+{
+  ZSTD_freeCCtx(cctx_);
+}
+
+Error
+ZstdCompressor::Init()
+{
+  cctx_ = ZSTD_createCCtx();
+  // Favor speed, the request is compressed while it is sent.
+  if ((cctx_ == nullptr) ||
+      ZSTD_isError(
+          ZSTD_CCtx_setParameter(cctx_, ZSTD_c_compressionLevel, 1))) {
+    return Error("failed to initialize state for zstd data compression");
+  }
+  return Error::Success;
+}
+
+Error
+ZstdCompressor::Compress(
+    std::deque<std::pair<uint8_t*, size_t>>* source, uint8_t* buf,
+    size_t size, size_t* output_bytes)
+{
+  ZSTD_outBuffer output{buf, size, 0};
+  while ((output.pos < output.size) && !finished_) {
+    DropConsumed(source);
+    if (!source->empty()) {
+      ZSTD_inBuffer input{source->front().first, source->front().second, 0};
+      const size_t ret =
+          ZSTD_compressStream2(cctx_, &output, &input, ZSTD_e_continue);
+      if (ZSTD_isError(ret)) {
+        return Error(
+            std::string("failed to compress data: ") + ZSTD_getErrorName(ret));
+      }
+      Consume(source, input.pos);
+    } else {
+      ZSTD_inBuffer input{nullptr, 0, 0};
+      const size_t remaining =
+          ZSTD_compressStream2(cctx_, &output, &input, ZSTD_e_end);
+      if (ZSTD_isError(remaining)) {
+        return Error(
+            std::string("failed to compress data: ") +
+            ZSTD_getErrorName(remaining));
+      }
+      finished_ = (remaining == 0);
+    }
+  }
+  *output_bytes = output.pos;
+  return Error::Success;
+}
+#endif  // TRITON_ENABLE_ZSTD
+
+#ifdef TRITON_ENABLE_LZ4
+// The LZ4 frame API writes a whole block at a time, so the compressed
+// blocks are staged and copied out as libcurl asks for more data.
+class Lz4Compressor : public RequestCompressor {
+ public:
+  Lz4Compressor()
+      : cctx_(nullptr), begun_(false), staged_offset_(0), staged_size_(0)
+  {
+  }
+  ~Lz4Compressor();
+
+  Error Init();
+  Error Compress(
+      std::deque<std::pair<uint8_t*, size_t>>* source, uint8_t* buf,
+      size_t size, size_t* output_bytes) override;
+
+ private:
+  static constexpr size_t kBlockByteSize = 64 * 1024;
+
+  LZ4F_cctx* cctx_;
+  LZ4F_preferences_t preferences_;
+  bool begun_;
+  std::vector<char> staged_;
+  size_t staged_offset_;
+  size_t staged_size_;
+};
+
+constexpr size_t Lz4Compressor::kBlockByteSize;
+
+Lz4Compressor::~Lz4Compressor()
+{
+  LZ4F_freeCompressionContext(cctx_);
+}
+
+Error
+Lz4Compressor::Init()
+{
+  if (LZ4F_isError(LZ4F_createCompressionContext(&cctx_, LZ4F_VERSION))) {
+    return Error("failed to initialize state for lz4 data compression");
+  }
+  preferences_ = LZ4F_preferences_t();
+  preferences_.frameInfo.blockSizeID = LZ4F_max64KB;
+  staged_.resize(
+      (std::max)(
+          LZ4F_compressBound(kBlockByteSize, &preferences_),
+          static_cast<size_t>(LZ4F_HEADER_SIZE_MAX)));
+  return Error::Success;
+}
+
+Error
+Lz4Compressor::Compress(
+    std::deque<std::pair<uint8_t*, size_t>>* source, uint8_t* buf,
+    size_t size, size_t* output_bytes)
+{
+  *output_bytes = 0;
+  while (*output_bytes < size) {
+    if (staged_offset_ < staged_size_) {
+      const size_t copy_size =
+          (std::min)(staged_size_ - staged_offset_, size - *output_bytes);
+      std::copy(
+          staged_.data() + staged_offset_,
+          staged_.data() + staged_offset_ + copy_size, buf + *output_bytes);
+      staged_offset_ += copy_size;
+      *output_bytes += copy_size;
+      continue;
+    }
+    if (finished_) {
+      break;
+    }
+
+    size_t ret;
+    DropConsumed(source);
+    if (!begun_) {
+      ret = LZ4F_compressBegin(
+          cctx_, staged_.data(), staged_.size(), &preferences_);
+      begun_ = true;
+    } else if (!source->empty()) {
+      const size_t input_size =
+          (std::min)(source->front().second, kBlockByteSize);
+      ret = LZ4F_compressUpdate(
+          cctx_, staged_.data(), staged_.size(), source->front().first,
+          input_size, nullptr);
+      Consume(source, input_size);
+    } else {
+      ret = LZ4F_compressEnd(cctx_, staged_.data(), staged_.size(), nullptr);
+      finished_ = true;
+    }
+    if (LZ4F_isError(ret)) {
+      return Error(
+          std::string("failed to compress data: ") + LZ4F_getErrorName(ret));
+    }
+    staged_offset_ = 0;
+    staged_size_ = ret;
+  }
+  return Error::Success;
+}
+#endif  // TRITON_ENABLE_LZ4
+
+}  // namespace
+
+Error
+RequestCompressor::Create(
+    const InferenceServerHttpClient::CompressionType type,
+    std::unique_ptr<RequestCompressor>* compressor)
+{
+  switch (type) {
+    case InferenceServerHttpClient::CompressionType::DEFLATE:
+    case InferenceServerHttpClient::CompressionType::GZIP: {
+      std::unique_ptr<ZlibCompressor> zlib_compressor(new ZlibCompressor());
+      Error err = zlib_compressor->Init(type);
+      if (!err.IsOk()) {
+        return err;
+      }
+      compressor->reset(zlib_compressor.release());
+      return Error::Success;
+    }
+    case InferenceServerHttpClient::CompressionType::ZSTD: {
+#ifdef TRITON_ENABLE_ZSTD
+      std::unique_ptr<ZstdCompressor> zstd_compressor(new ZstdCompressor());
+      Error err = zstd_compressor->Init();
+      if (!err.IsOk()) {
+        return err;
+      }
+      compressor->reset(zstd_compressor.release());
+      return Error::Success;
+#else
+      return Error("zstd compression is not enabled in this build");
+#endif  // TRITON_ENABLE_ZSTD
+    }
+    case InferenceServerHttpClient::CompressionType::LZ4: {
+#ifdef TRITON_ENABLE_LZ4
+      std::unique_ptr<Lz4Compressor> lz4_compressor(new Lz4Compressor());
+      Error err = lz4_compressor->Init();
+      if (!err.IsOk()) {
+        return err;
+      }
+      compressor->reset(lz4_compressor.release());
+      return Error::Success;
+#else
+      return Error("lz4 compression is not enabled in this build");
+#endif  // TRITON_ENABLE_LZ4
+    }
+    case InferenceServerHttpClient::CompressionType::NONE:
+      break;
+  }
+  return Error("can't compress data with NONE type");
+}
+
+}}  // namespace triton::client
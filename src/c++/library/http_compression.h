@@ -0,0 +1,80 @@
+// Copyright (c) 2026, NVIDIA CORPORATION. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <utility>
+#include "http_client.h"
+
+namespace triton { namespace client {
+
+// The compression of the request bodies of the HTTP client. This header is
+// internal to the client library and is not installed.
+//
+// libcurl provides automatic decompression, so only implement compression.
+// The request body is compressed while it is sent, the compressor pulls the
+// uncompressed data from the request buffers as libcurl asks for more data.
+class RequestCompressor {
+ public:
+  static Error Create(
+      const InferenceServerHttpClient::CompressionType type,
+      std::unique_ptr<RequestCompressor>* compressor);
+  virtual ~RequestCompressor() = default;
+
+  // Compress the data in 'source' into 'buf' of 'size' bytes, consuming
+  // 'source' as it goes. Return the number of bytes written in
+  // 'output_bytes', which is less than 'size' only once all of the
+  // compressed data has been produced.
+  virtual Error Compress(
+      std::deque<std::pair<uint8_t*, size_t>>* source, uint8_t* buf,
+      size_t size, size_t* output_bytes) = 0;
+
+  // Whether all of the compressed data has been produced.
+  bool Finished() const { return finished_; }
+
+ protected:
+  RequestCompressor() : finished_(false) {}
+
+  // Remove the fully consumed buffers at the front of 'source'.
+  static void DropConsumed(std::deque<std::pair<uint8_t*, size_t>>* source)
+  {
+    while (!source->empty() && (source->front().second == 0)) {
+      source->pop_front();
+    }
+  }
+  static void Consume(
+      std::deque<std::pair<uint8_t*, size_t>>* source, size_t byte_size)
+  {
+    source->front().first += byte_size;
+    source->front().second -= byte_size;
+  }
+
+  bool finished_;
+};
+
+}}  // namespace triton::client
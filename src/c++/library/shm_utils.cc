@@ -105,4 +105,201 @@ UnmapSharedMemory(void* shm_addr, size_t byte_size)
   return Error::Success;
 }
 
+//==============================================================================
+
+constexpr size_t SharedMemoryArena::kSliceAlignment;
+
+SharedMemoryArena::Slice::Slice()
+    : arena_(nullptr), seq_(0), data_(nullptr), byte_size_(0), offset_(0)
+{
+}
+
+SharedMemoryArena::Slice::~Slice()
+{
+  Release();
+}
+
+SharedMemoryArena::Slice::Slice(Slice&& other)
+    : arena_(other.arena_), seq_(other.seq_), data_(other.data_),
+      byte_size_(other.byte_size_), offset_(other.offset_)
+{
+  other.arena_ = nullptr;
+  other.data_ = nullptr;
+}
+
+SharedMemoryArena::Slice&
+SharedMemoryArena::Slice::operator=(Slice&& other)
+{
+  if (this != &other) {
+    Release();
+    arena_ = other.arena_;
+    seq_ = other.seq_;
+    data_ = other.data_;
+    byte_size_ = other.byte_size_;
+    offset_ = other.offset_;
+    other.arena_ = nullptr;
+    other.data_ = nullptr;
+  }
+  return *this;
+}
+
+Error
+SharedMemoryArena::Slice::SetSharedMemory(InferInput* input) const
+{
+  if (arena_ == nullptr) {
+    return Error("the shared memory slice is not allocated");
+  }
+  return input->SetSharedMemory(arena_->Name(), byte_size_, offset_);
+}
+
+Error
+SharedMemoryArena::Slice::SetSharedMemory(InferRequestedOutput* output) const
+{
+  if (arena_ == nullptr) {
+    return Error("the shared memory slice is not allocated");
+  }
+  return output->SetSharedMemory(arena_->Name(), byte_size_, offset_);
+}
+
+void
+SharedMemoryArena::Slice::Release()
+{
+  if (arena_ != nullptr) {
+    arena_->Release(*this);
+    arena_ = nullptr;
+    data_ = nullptr;
+  }
+}
+
+Error
+SharedMemoryArena::Create(
+    std::unique_ptr<SharedMemoryArena>* arena, const std::string& name,
+    const std::string& key, const size_t byte_size,
+    const RegisterFn& register_region, const UnregisterFn& unregister_region)
+{
+  if (byte_size == 0) {
+    return Error(
+        "the shared memory arena '" + name + "' must have a non-zero size");
+  }
+
+  std::unique_ptr<SharedMemoryArena> new_arena(
+      new SharedMemoryArena(name, key, byte_size));
+  // The arena destroys whatever part of the region was set up on error
+  Error err = CreateSharedMemoryRegion(key, byte_size, &new_arena->shm_fd_);
+  if (!err.IsOk()) {
+    return err;
+  }
+  void* base_addr;
+  err = MapSharedMemory(new_arena->shm_fd_, 0, byte_size, &base_addr);
+  if (!err.IsOk()) {
+    return err;
+  }
+  new_arena->base_addr_ = reinterpret_cast<uint8_t*>(base_addr);
+
+  if (register_region != nullptr) {
+    err = register_region(name, key, byte_size);
+    if (!err.IsOk()) {
+      return err;
+    }
+  }
+  new_arena->unregister_region_ = unregister_region;
+
+  *arena = std::move(new_arena);
+  return Error::Success;
+}
+
+SharedMemoryArena::SharedMemoryArena(
+    const std::string& name, const std::string& key, const size_t byte_size)
+    : name_(name), key_(key), byte_size_(byte_size), shm_fd_(-1),
+      base_addr_(nullptr), front_seq_(0), head_(0)
+{
+}
+
+SharedMemoryArena::~SharedMemoryArena()
+{
+  Error err = Unregister();
+  if (!err.IsOk()) {
+    std::cerr << "Failed to unregister shared memory arena '" << name_
+              << "': " << err << std::endl;
+  }
+  if (base_addr_ != nullptr) {
+    UnmapSharedMemory(base_addr_, byte_size_);
+  }
+  if (shm_fd_ != -1) {
+    CloseSharedMemory(shm_fd_);
+    UnlinkSharedMemoryRegion(key_);
+  }
+}
+
+Error
+SharedMemoryArena::Unregister()
+{
+  if (unregister_region_ == nullptr) {
+    return Error::Success;
+  }
+  UnregisterFn unregister_region = std::move(unregister_region_);
+  unregister_region_ = nullptr;
+  return unregister_region(name_);
+}
+
+Error
+SharedMemoryArena::Allocate(const size_t byte_size, Slice* slice)
+{
+  slice->Release();
+  if (byte_size == 0) {
+    return Error("unable to allocate an empty shared memory slice");
+  }
+  const size_t reserved_byte_size =
+      ((byte_size + kSliceAlignment - 1) / kSliceAlignment) * kSliceAlignment;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  // The live slices occupy [tail, head) if they don't wrap around the end
+  // of the region, [tail, end) and [0, head) otherwise.
+  size_t offset = byte_size_;
+  if (allocations_.empty()) {
+    head_ = 0;
+    if (reserved_byte_size <= byte_size_) {
+      offset = 0;
+    }
+  } else {
+    const size_t tail = allocations_.front().offset_;
+    if (head_ > tail) {
+      if (reserved_byte_size <= (byte_size_ - head_)) {
+        offset = head_;
+      } else if (reserved_byte_size <= tail) {
+        offset = 0;
+      }
+    } else if (reserved_byte_size <= (tail - head_)) {
+      offset = head_;
+    }
+  }
+  if (offset == byte_size_) {
+    return Error(
+        "shared memory arena '" + name_ + "' has no room for a slice of " +
+        std::to_string(byte_size) + " bytes");
+  }
+
+  allocations_.push_back(Allocation{offset, reserved_byte_size, false});
+  head_ = offset + reserved_byte_size;
+
+  slice->arena_ = this;
+  slice->seq_ = front_seq_ + allocations_.size() - 1;
+  slice->data_ = base_addr_ + offset;
+  slice->byte_size_ = byte_size;
+  slice->offset_ = offset;
+  return Error::Success;
+}
+
+void
+SharedMemoryArena::Release(const Slice& slice)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  allocations_[slice.seq_ - front_seq_].released_ = true;
+  // Reclaim the space of the oldest slices, up to the first one in use
+  while (!allocations_.empty() && allocations_.front().released_) {
+    allocations_.pop_front();
+    ++front_seq_;
+  }
+}
+
 }}  // namespace triton::client
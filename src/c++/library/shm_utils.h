@@ -25,6 +25,11 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
 #include "common.h"
 
 namespace triton { namespace client {
@@ -63,4 +68,164 @@ Error UnlinkSharedMemoryRegion(std::string shm_key);
 // \return error Returns an error if unable to unmap shared memory region.
 Error UnmapSharedMemory(void* shm_addr, size_t byte_size);
 
+// A SharedMemoryArena is a single system shared memory region, registered
+// with the server once, that hands out slices to the inputs and outputs of
+// the requests in flight. Slices are allocated in a ring: a slice is taken
+// after the most recent one and the space is reclaimed, oldest first, once
+// the slices are released. A slice released early is reclaimed when the
+// slices allocated before it are released.
+//
+// \code
+//   std::unique_ptr<SharedMemoryArena> arena;
+//   SharedMemoryArena::Create(
+//       &arena, "arena", "/arena", 64 * 1024 * 1024,
+//       [&client](
+//           const std::string& name, const std::string& key,
+//           const size_t byte_size) {
+//         return client->RegisterSystemSharedMemory(name, key, byte_size);
+//       },
+//       [&client](const std::string& name) {
+//         return client->UnregisterSystemSharedMemory(name);
+//       });
+//   SharedMemoryArena::Slice input_slice, output_slice;
+//   arena->Allocate(input_byte_size, &input_slice);
+//   arena->Allocate(output_byte_size, &output_slice);
+//   // Write the input data at input_slice.Data()
+//   input_slice.SetSharedMemory(input);
+//   output_slice.SetSharedMemory(output);
+//   client->AsyncInfer(...);
+//   // Both slices are released once the result has been read
+// \endcode
+class SharedMemoryArena {
+ public:
+  // A slice of the arena, released when destroyed. A slice must not
+  // outlive its arena.
+  class Slice {
+   public:
+    Slice();
+    ~Slice();
+    Slice(Slice&& other);
+    Slice& operator=(Slice&& other);
+    Slice(const Slice&) = delete;
+    Slice& operator=(const Slice&) = delete;
+
+    // The address of the slice in this process, nullptr if the slice is
+    // not allocated.
+    void* Data() const { return data_; }
+    // The byte size requested for the slice.
+    size_t ByteSize() const { return byte_size_; }
+    // The offset of the slice in the region.
+    size_t Offset() const { return offset_; }
+
+    // Set 'input' to read its data from the slice.
+    // \param input The input to set.
+    // \return error Returns an error if the slice is not allocated.
+    Error SetSharedMemory(InferInput* input) const;
+
+    // Set 'output' to be written to the slice.
+    // \param output The output to set.
+    // \return error Returns an error if the slice is not allocated.
+    Error SetSharedMemory(InferRequestedOutput* output) const;
+
+    // Give the slice back to the arena, the slice must not be in use by
+    // a request in flight.
+    void Release();
+
+   private:
+    friend class SharedMemoryArena;
+
+    SharedMemoryArena* arena_;
+    // The sequence number of the slice in the arena
+    uint64_t seq_;
+    void* data_;
+    size_t byte_size_;
+    size_t offset_;
+  };
+
+  // The function registering the region with the server, usually the
+  // RegisterSystemSharedMemory() function of a client.
+  using RegisterFn = std::function<Error(
+      const std::string& name, const std::string& key,
+      const size_t byte_size)>;
+  // The function unregistering the region from the server, usually the
+  // UnregisterSystemSharedMemory() function of a client.
+  using UnregisterFn = std::function<Error(const std::string& name)>;
+
+  // Create the shared memory region of the arena and map it.
+  // \param arena Returns a new SharedMemoryArena object.
+  // \param name The name the region is registered with.
+  // \param key The string identifier of the shared memory region.
+  // \param byte_size The size in bytes of the shared memory region.
+  // \param register_region Optional function registering the region with
+  // the server. If not provided the region must be registered by the
+  // caller before any slice is used.
+  // \param unregister_region Optional function unregistering the region
+  // from the server, called by Unregister() or when the arena is destroyed.
+  // If not provided the region must be unregistered by the caller before
+  // the arena is destroyed.
+  // \return error Returns an error if unable to create, map or register
+  // the shared memory region.
+  static Error Create(
+      std::unique_ptr<SharedMemoryArena>* arena, const std::string& name,
+      const std::string& key, const size_t byte_size,
+      const RegisterFn& register_region = nullptr,
+      const UnregisterFn& unregister_region = nullptr);
+
+  // Unregister the region if not done yet, then unmap and destroy it.
+  ~SharedMemoryArena();
+
+  // Unregister the region from the server with the function provided to
+  // Create(). Does nothing if no such function was provided or if the
+  // region is already unregistered. No slice may be used by a request
+  // once the region is unregistered.
+  // \return error Returns an error if unable to unregister the region.
+  Error Unregister();
+
+  // Allocate a slice of 'byte_size' bytes. The slices are aligned to
+  // 'kSliceAlignment'.
+  // \param byte_size The size in bytes of the slice.
+  // \param slice Returns the slice, any slice it held is released first.
+  // \return error Returns an error if the arena has no room for the slice
+  // until older slices are released.
+  Error Allocate(const size_t byte_size, Slice* slice);
+
+  // The name the region is registered with.
+  const std::string& Name() const { return name_; }
+  // The string identifier of the shared memory region.
+  const std::string& Key() const { return key_; }
+  // The size in bytes of the shared memory region.
+  size_t ByteSize() const { return byte_size_; }
+
+  static constexpr size_t kSliceAlignment = 64;
+
+ private:
+  SharedMemoryArena(
+      const std::string& name, const std::string& key, const size_t byte_size);
+  void Release(const Slice& slice);
+
+  // The space of a slice in the ring, 'reserved_byte_size_' is the byte
+  // size of the slice rounded up to the alignment.
+  struct Allocation {
+    size_t offset_;
+    size_t reserved_byte_size_;
+    bool released_;
+  };
+
+  const std::string name_;
+  const std::string key_;
+  const size_t byte_size_;
+  int shm_fd_;
+  uint8_t* base_addr_;
+  // The function unregistering the region, nullptr once it is called
+  UnregisterFn unregister_region_;
+
+  std::mutex mutex_;
+  // The allocations not yet reclaimed, oldest first. The front one has
+  // sequence number 'front_seq_'.
+  std::deque<Allocation> allocations_;
+  uint64_t front_seq_;
+  // The offset the next slice is allocated at if it fits.
+  size_t head_;
+};
+
 }}  // namespace triton::client
@@ -26,10 +26,56 @@
 
 #include "concurrency_manager.h"
 
-#include <queue>
+#include <limits>
 
 namespace triton { namespace perfanalyzer {
 
+namespace {
+
+// The request id of the request in 'slot' of the request table, whose
+// 'generation' tells it apart from the other requests that use the slot.
+std::string
+RequestSlotId(const uint32_t slot, const uint32_t generation)
+{
+  return std::to_string(slot) + "." + std::to_string(generation);
+}
+
+// Returns true and the slot and generation named by 'request_id' in 'slot'
+// and 'generation' if 'request_id' was created by RequestSlotId() for one of
+// the 'slot_count' slots.
+bool
+ParseRequestSlotId(
+    const std::string& request_id, const size_t slot_count, uint32_t* slot,
+    uint32_t* generation)
+{
+  uint64_t values[2] = {0, 0};
+  size_t index = 0;
+  bool has_digit = false;
+  for (const char c : request_id) {
+    if ((c == '.') && (index == 0) && has_digit) {
+      index = 1;
+      has_digit = false;
+      continue;
+    }
+    if ((c < '0') || (c > '9')) {
+      return false;
+    }
+    values[index] = values[index] * 10 + (c - '0');
+    if (values[index] > std::numeric_limits<uint32_t>::max()) {
+      return false;
+    }
+    has_digit = true;
+  }
+  if ((index != 1) || !has_digit || (values[0] >= slot_count)) {
+    return false;
+  }
+  *slot = values[0];
+  *generation = values[1];
+  return true;
+}
+
+}  // namespace
+
 ConcurrencyManager::~ConcurrencyManager()
 {
   // The destruction of derived class should wait for all the request generator
@@ -162,7 +208,8 @@ ConcurrencyManager::Infer(
 {
   std::vector<std::unique_ptr<InferContext>> ctxs;
   uint32_t seq_id = 0, ctx_id = 0;
-  std::queue<int> free_ctx_ids;
+  FreeList free_ctx_ids;
+  free_ctx_ids.Reserve(max_concurrency_);
 
   // Reserve the vectors in case of sequence models. In non-sequence or
   // synchronous mode only one context will be opened hence no need of
@@ -178,42 +225,79 @@ ConcurrencyManager::Infer(
   std::condition_variable cb_cv;
 
   std::atomic<int> total_ongoing_requests(0);
-  uint64_t request_id = 0;
 
-  // request_id to start timestamp map
-  std::map<std::string, AsyncRequestProperties> async_req_map;
+  // The asynchronous requests in flight, the number of the slot of a request
+  // is used as its request id. The table is sized to the maximum concurrency
+  // and only grows when the concurrency is not bounded. Both the table and
+  // 'free_slots' are protected by 'cb_mtx'.
+  std::vector<AsyncRequestProperties> async_req_table;
+  FreeList free_slots;
+  if (async_) {
+    async_req_table.resize(max_concurrency_);
+    free_slots.Reserve(max_concurrency_);
+    for (size_t i = max_concurrency_; i > 0; --i) {
+      free_slots.Push(i - 1);
+    }
+  }
 
   // Callback function for handling asynchronous requests
   const auto callback_func = [&](cb::InferResult* result) {
     uint32_t ctx_id = 0;
+    uint32_t slot = 0;
+    uint32_t generation = 0;
+    bool tracked = false;
     std::shared_ptr<cb::InferResult> result_ptr(result);
     if (thread_stat->cb_status_.IsOk()) {
-      // Add the request timestamp to thread Timestamp vector with
-      // proper locking
-      std::lock_guard<std::mutex> lock(thread_stat->mu_);
       thread_stat->cb_status_ = result_ptr->RequestStatus();
       if (thread_stat->cb_status_.IsOk()) {
         struct timespec end_time_async;
         clock_gettime(CLOCK_MONOTONIC, &end_time_async);
         std::string request_id;
         thread_stat->cb_status_ = result_ptr->Id(&request_id);
-        const auto& it = async_req_map.find(request_id);
-        if (it != async_req_map.end()) {
-          thread_stat->request_timestamps_.emplace_back(std::make_tuple(
-              it->second.start_time_, end_time_async, it->second.sequence_end_,
-              false /* delayed */));
-          ctx_id = it->second.ctx_id_;
-          ctxs[ctx_id]->infer_backend_->ClientInferStat(
-              &(thread_stat->contexts_stat_[ctx_id]));
+        AsyncRequestProperties request;
+        {
+          std::lock_guard<std::mutex> lk(cb_mtx);
+          if (ParseRequestSlotId(
+                  request_id, async_req_table.size(), &slot, &generation)) {
+            // Only the first response to the request in the slot is
+            // recorded, e.g. decoupled models may send several responses
+            // with the same id, possibly after the slot is reused.
+            AsyncRequestProperties& entry = async_req_table[slot];
+            tracked = entry.in_use_ && (entry.generation_ == generation);
+            if (tracked) {
+              entry.in_use_ = false;
+              request = entry;
+            }
+          }
+        }
+        if (tracked) {
+          thread_stat->request_timestamps_.Push(
+              request.start_time_, end_time_async, request.sequence_end_,
+              false /* delayed */, 0 /* schedule_lateness_ns */);
+          ctx_id = request.ctx_id_;
+          {
+            // The lock protects the context statistics
+            std::lock_guard<std::mutex> lock(thread_stat->mu_);
+            ctxs[ctx_id]->infer_backend_->ClientInferStat(
+                &(thread_stat->contexts_stat_[ctx_id]));
+          }
           thread_stat->cb_status_ = ValidateOutputs(*ctxs[ctx_id], result);
-          async_req_map.erase(request_id);
         }
       }
     }
     // avoid competition over 'cb_mtx'
     {
       std::lock_guard<std::mutex> lk(cb_mtx);
-      free_ctx_ids.push(ctx_id);
+      if (tracked) {
+        free_slots.Push(slot);
+      }
+      // Only sequence models take their context from 'free_ctx_ids'. The
+      // context is only known for a tracked request, the untracked ones
+      // either complete the sequences without taking a context or are
+      // responses whose request was already completed.
+      if (on_sequence_model_ && tracked) {
+        free_ctx_ids.Push(ctx_id);
+      }
       notified = true;
     }
 
@@ -260,7 +344,8 @@ ConcurrencyManager::Infer(
         sequence_stat_[seq_id]->remaining_queries_--;
 
         if (async_) {
-          ctxs[ctx_id]->options_->request_id_ = "0";
+          // Requests completing the sequences are not tracked
+          ctxs[ctx_id]->options_->request_id_.clear();
           if (streaming_) {
             RETURN_IF_ERROR(ctxs[ctx_id]->infer_backend_->AsyncStreamInfer(
                 *(ctxs[ctx_id]->options_), ctxs[ctx_id]->inputs_,
@@ -300,9 +385,9 @@ ConcurrencyManager::Infer(
         }
         // Reconstruct 'free_ctx_ids' because complete_onging_sequence_func()
         // has destructive side affects
-        free_ctx_ids = std::queue<int>();
-        for (size_t i = 0; i < ctxs.size(); ++i) {
-          free_ctx_ids.push(i);
+        free_ctx_ids.Clear();
+        for (size_t i = ctxs.size(); i > 0; --i) {
+          free_ctx_ids.Push(i - 1);
         }
         // Wait if no request should be sent and it is not exiting
         thread_config->is_paused_ = true;
@@ -333,7 +418,7 @@ ConcurrencyManager::Infer(
     while (active_ctx_cnt > ctxs.size()) {
       {
         std::lock_guard<std::mutex> lock(cb_mtx);
-        free_ctx_ids.push(ctxs.size());
+        free_ctx_ids.Push(ctxs.size());
       }
       ctxs.emplace_back(new InferContext());
       thread_stat->status_ =
@@ -393,8 +478,7 @@ ConcurrencyManager::Infer(
         // Find the next available context id to use for this request
         {
           std::lock_guard<std::mutex> lk(cb_mtx);
-          ctx_id = free_ctx_ids.front();
-          free_ctx_ids.pop();
+          ctx_id = free_ctx_ids.Pop();
         }
         seq_id = offset + ctx_id;
 
@@ -425,17 +509,23 @@ ConcurrencyManager::Infer(
         }
       }
       if (async_) {
-        ctxs[ctx_id]->options_->request_id_ = std::to_string(request_id++);
         {
-          std::lock_guard<std::mutex> lock(thread_stat->mu_);
-          auto it = async_req_map
-                        .emplace(
-                            ctxs[ctx_id]->options_->request_id_,
-                            AsyncRequestProperties())
-                        .first;
-          clock_gettime(CLOCK_MONOTONIC, &(it->second.start_time_));
-          it->second.ctx_id_ = ctx_id;
-          it->second.sequence_end_ = ctxs[ctx_id]->options_->sequence_end_;
+          std::lock_guard<std::mutex> lk(cb_mtx);
+          uint32_t slot;
+          if (free_slots.Empty()) {
+            slot = async_req_table.size();
+            async_req_table.emplace_back();
+          } else {
+            slot = free_slots.Pop();
+          }
+          AsyncRequestProperties& request = async_req_table[slot];
+          request.ctx_id_ = ctx_id;
+          request.sequence_end_ = ctxs[ctx_id]->options_->sequence_end_;
+          request.generation_++;
+          request.in_use_ = true;
+          ctxs[ctx_id]->options_->request_id_ =
+              RequestSlotId(slot, request.generation_);
+          clock_gettime(CLOCK_MONOTONIC, &request.start_time_);
         }
         if (streaming_) {
           thread_stat->status_ = ctxs[ctx_id]->infer_backend_->AsyncStreamInfer(
@@ -466,22 +556,21 @@ ConcurrencyManager::Infer(
           return;
         }
         clock_gettime(CLOCK_MONOTONIC, &end_time_sync);
+        thread_stat->request_timestamps_.Push(
+            start_time_sync, end_time_sync,
+            ctxs[ctx_id]->options_->sequence_end_, false /* delayed */,
+            0 /* schedule_lateness_ns */);
         {
-          // Add the request timestamp to thread Timestamp vector with proper
-          // locking
           std::lock_guard<std::mutex> lock(thread_stat->mu_);
-          thread_stat->request_timestamps_.emplace_back(std::make_tuple(
-              start_time_sync, end_time_sync,
-              ctxs[ctx_id]->options_->sequence_end_, false /* delayed */));
           thread_stat->status_ = ctxs[ctx_id]->infer_backend_->ClientInferStat(
               &(thread_stat->contexts_stat_[ctx_id]));
           if (!thread_stat->status_.IsOk()) {
             return;
           }
         }
-        {
+        if (on_sequence_model_) {
           std::lock_guard<std::mutex> lock(cb_mtx);
-          free_ctx_ids.push(ctx_id);
+          free_ctx_ids.Push(ctx_id);
         }
       }
       total_ongoing_requests++;
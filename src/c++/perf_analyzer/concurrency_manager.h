@@ -99,6 +99,25 @@ class ConcurrencyManager : public LoadManager {
       const std::shared_ptr<ModelParser>& parser,
       const std::shared_ptr<cb::ClientBackendFactory>& factory);
 
+  // A preallocated stack of free indices. Unlike a queue, taking and
+  // returning an index never allocates.
+  class FreeList {
+   public:
+    void Reserve(const size_t capacity) { free_.reserve(capacity); }
+    void Clear() { free_.clear(); }
+    bool Empty() const { return free_.empty(); }
+    void Push(const uint32_t index) { free_.push_back(index); }
+    uint32_t Pop()
+    {
+      const uint32_t index = free_.back();
+      free_.pop_back();
+      return index;
+    }
+
+   private:
+    std::vector<uint32_t> free_;
+  };
+
   struct ThreadConfig {
     ThreadConfig(size_t thread_id)
         : thread_id_(thread_id), concurrency_(0),
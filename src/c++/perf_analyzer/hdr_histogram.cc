@@ -0,0 +1,169 @@
+// Copyright (c) 2026, NVIDIA CORPORATION. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "hdr_histogram.h"
+
+#include <math.h>
+#include <algorithm>
+#include <limits>
+
+namespace triton { namespace perfanalyzer {
+
+HdrHistogram::HdrHistogram(const uint32_t significant_digits)
+    : significant_digits_(
+          (std::min)((std::max)(significant_digits, 1u), 5u)),
+      count_(0), sum_(0), sum_of_squares_(0),
+      min_((std::numeric_limits<uint64_t>::max)()), max_(0)
+{
+  // The sub-buckets of a power of two must tell apart the values that
+  // differ in their last significant digit, i.e. there must be at least
+  // 10^significant_digits of them.
+  uint64_t sub_bucket_count = 1;
+  for (uint32_t i = 0; i < significant_digits_; ++i) {
+    sub_bucket_count *= 10;
+  }
+  sub_bucket_bits_ = 1;
+  while ((uint64_t(1) << (sub_bucket_bits_ - 1)) < sub_bucket_count) {
+    ++sub_bucket_bits_;
+  }
+}
+
+size_t
+HdrHistogram::CountIndex(const uint64_t value) const
+{
+  const uint64_t exact_count = (uint64_t(1) << sub_bucket_bits_);
+  if (value < exact_count) {
+    return value;
+  }
+
+  size_t msb = 0;
+  for (uint64_t v = value; v > 1; v >>= 1) {
+    ++msb;
+  }
+  const size_t shift = msb - (sub_bucket_bits_ - 1);
+  const uint64_t half_count = exact_count >> 1;
+  return exact_count + (shift - 1) * half_count +
+         ((value >> shift) - half_count);
+}
+
+uint64_t
+HdrHistogram::HighestEquivalentValue(const size_t index) const
+{
+  const uint64_t exact_count = (uint64_t(1) << sub_bucket_bits_);
+  if (index < exact_count) {
+    return index;
+  }
+
+  const uint64_t half_count = exact_count >> 1;
+  const size_t shift = (index - exact_count) / half_count + 1;
+  const uint64_t sub_bucket = half_count + (index - exact_count) % half_count;
+  return ((sub_bucket + 1) << shift) - 1;
+}
+
+void
+HdrHistogram::Record(const uint64_t value)
+{
+  const size_t index = CountIndex(value);
+  if (index >= counts_.size()) {
+    counts_.resize(index + 1, 0);
+  }
+  ++counts_[index];
+  ++count_;
+  sum_ += value;
+  sum_of_squares_ += (double)value * value;
+  min_ = (std::min)(min_, value);
+  max_ = (std::max)(max_, value);
+}
+
+cb::Error
+HdrHistogram::Merge(const HdrHistogram& other)
+{
+  if (other.significant_digits_ != significant_digits_) {
+    return cb::Error(
+        "unable to merge a histogram of " +
+        std::to_string(other.significant_digits_) +
+        " significant digits into one of " +
+        std::to_string(significant_digits_));
+  }
+
+  if (other.counts_.size() > counts_.size()) {
+    counts_.resize(other.counts_.size(), 0);
+  }
+  for (size_t i = 0; i < other.counts_.size(); ++i) {
+    counts_[i] += other.counts_[i];
+  }
+  count_ += other.count_;
+  sum_ += other.sum_;
+  sum_of_squares_ += other.sum_of_squares_;
+  min_ = (std::min)(min_, other.min_);
+  max_ = (std::max)(max_, other.max_);
+  return cb::Error::Success;
+}
+
+void
+HdrHistogram::Reset()
+{
+  counts_.clear();
+  count_ = 0;
+  sum_ = 0;
+  sum_of_squares_ = 0;
+  min_ = (std::numeric_limits<uint64_t>::max)();
+  max_ = 0;
+}
+
+double
+HdrHistogram::StdDev() const
+{
+  if (count_ == 0) {
+    return 0;
+  }
+  const double mean = (double)sum_ / count_;
+  const double variance = sum_of_squares_ / count_ - mean * mean;
+  return (variance > 0) ? sqrt(variance) : 0;
+}
+
+uint64_t
+HdrHistogram::ValueAtPercentile(const double percentile) const
+{
+  if (count_ == 0) {
+    return 0;
+  }
+
+  const double clamped_percentile =
+      (std::min)((std::max)(percentile, 0.0), 100.0);
+  const uint64_t rank =
+      (uint64_t)((clamped_percentile / 100.0) * (count_ - 1) + 0.5);
+  uint64_t seen = 0;
+  for (size_t i = 0; i < counts_.size(); ++i) {
+    seen += counts_[i];
+    if (seen > rank) {
+      return (std::max)((std::min)(HighestEquivalentValue(i), max_), Min());
+    }
+  }
+  return max_;
+}
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,106 @@
+// Copyright (c) 2026, NVIDIA CORPORATION. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "client_backend/client_backend.h"
+
+namespace cb = triton::perfanalyzer::clientbackend;
+
+namespace triton { namespace perfanalyzer {
+
+//==============================================================================
+/// A histogram of latencies in the style of HdrHistogram: each power of two
+/// is split into linear sub-buckets, as many as needed for the values to be
+/// recorded with the configured number of significant decimal digits. The
+/// memory used only depends on the precision and on the largest value
+/// recorded, not on the number of values. Histograms of the same precision
+/// can be merged. The mean and standard deviation are exact, the
+/// percentiles are accurate to the precision of the histogram.
+///
+class HdrHistogram {
+ public:
+  /// Create an empty histogram.
+  /// \param significant_digits The number of significant decimal digits the
+  /// values are recorded with, between 1 and 5.
+  explicit HdrHistogram(const uint32_t significant_digits = 3);
+
+  /// Record a value.
+  /// \param value The value to record.
+  void Record(const uint64_t value);
+
+  /// Add the values recorded by 'other' to this histogram.
+  /// \param other The histogram to merge, it must have the same precision.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error Merge(const HdrHistogram& other);
+
+  /// Remove all the values recorded.
+  void Reset();
+
+  /// \return The number of values recorded.
+  uint64_t Count() const { return count_; }
+
+  /// \return The sum of the values recorded.
+  uint64_t Sum() const { return sum_; }
+
+  /// \return The smallest value recorded, 0 if none.
+  uint64_t Min() const { return (count_ == 0) ? 0 : min_; }
+
+  /// \return The largest value recorded, 0 if none.
+  uint64_t Max() const { return max_; }
+
+  /// \return The standard deviation of the values recorded.
+  double StdDev() const;
+
+  /// Get the value at a percentile, as the value at index
+  /// 'percentile / 100 * (count - 1)', rounded, of the sorted values.
+  /// \param percentile The percentile, between 0 and 100. Fractional
+  /// percentiles such as 99.99 are supported.
+  /// \return The highest value equivalent, within the precision, to the
+  /// value at the percentile. 0 if no value is recorded.
+  uint64_t ValueAtPercentile(const double percentile) const;
+
+ private:
+  // The index of the sub-bucket counting 'value'.
+  size_t CountIndex(const uint64_t value) const;
+  // The highest value counted by the sub-bucket at 'index'.
+  uint64_t HighestEquivalentValue(const size_t index) const;
+
+  const uint32_t significant_digits_;
+  // The values below 2^sub_bucket_bits_ are recorded exactly, each power
+  // of two above is split into 2^(sub_bucket_bits_ - 1) sub-buckets.
+  uint32_t sub_bucket_bits_;
+  // The counts of the sub-buckets, grown to the largest value recorded.
+  std::vector<uint64_t> counts_;
+  uint64_t count_;
+  uint64_t sum_;
+  double sum_of_squares_;
+  uint64_t min_;
+  uint64_t max_;
+};
+
+}}  // namespace triton::perfanalyzer
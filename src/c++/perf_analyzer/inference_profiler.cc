@@ -26,7 +26,6 @@
 
 #include "inference_profiler.h"
 
-#include <math.h>
 #include <algorithm>
 #include <limits>
 #include <queue>
@@ -35,6 +34,11 @@
 namespace triton { namespace perfanalyzer {
 namespace {
 
+// How often the request timestamps are collected from the workers during a
+// measurement. At this interval the default ring of a worker holds more
+// than 600k requests per second.
+constexpr std::chrono::milliseconds kTimestampCollectionInterval(100);
+
 inline uint64_t
 AverageDurationInUs(const uint64_t total_time_in_ns, const uint64_t cnt)
 {
@@ -311,6 +315,15 @@ ReportClientSideStats(
     std::cout << "    Delayed Request Count: " << stats.delayed_request_count
               << std::endl;
   }
+  if (!stats.percentile_schedule_lateness_ns.empty()) {
+    std::cout << "    Schedule lateness:";
+    for (const auto& percentile : stats.percentile_schedule_lateness_ns) {
+      std::cout << " p" << percentile.first << " "
+                << (percentile.second / 1000) << " usec,";
+    }
+    std::cout << " max " << (stats.max_schedule_lateness_ns / 1000) << " usec"
+              << std::endl;
+  }
   if (on_sequence_model) {
     std::cout << "    Sequence count: " << stats.sequence_count << " ("
               << stats.sequence_per_sec << " seq/sec)" << std::endl;
@@ -326,6 +339,18 @@ ReportClientSideStats(
               << " latency: " << (percentile.second / 1000) << " usec"
               << std::endl;
   }
+  if (!stats.percentile_latency_from_schedule_ns.empty()) {
+    std::cout << "    Avg latency from schedule: "
+              << (stats.avg_latency_from_schedule_ns / 1000)
+              << " usec (schedule delay "
+              << (stats.avg_schedule_lateness_ns / 1000) << " usec)"
+              << std::endl;
+    for (const auto& percentile : stats.percentile_latency_from_schedule_ns) {
+      std::cout << "    p" << percentile.first
+                << " latency from schedule: " << (percentile.second / 1000)
+                << " usec" << std::endl;
+    }
+  }
 
   std::cout << client_library_detail << std::endl;
 
@@ -363,13 +388,15 @@ InferenceProfiler::Create(
     std::unique_ptr<cb::ClientBackend> profile_backend,
     std::unique_ptr<LoadManager> manager,
     std::unique_ptr<InferenceProfiler>* profiler,
-    uint64_t measurement_request_count, MeasurementMode measurement_mode)
+    uint64_t measurement_request_count, MeasurementMode measurement_mode,
+    const uint32_t latency_significant_digits,
+    const bool latency_from_schedule)
 {
   std::unique_ptr<InferenceProfiler> local_profiler(new InferenceProfiler(
       verbose, stability_threshold, measurement_window_ms, max_trials,
       (percentile != -1), percentile, latency_threshold_ms_, protocol, parser,
       std::move(profile_backend), std::move(manager), measurement_request_count,
-      measurement_mode));
+      measurement_mode, latency_significant_digits, latency_from_schedule));
 
   *profiler = std::move(local_profiler);
   return cb::Error::Success;
@@ -383,10 +410,14 @@ InferenceProfiler::InferenceProfiler(
     std::shared_ptr<ModelParser>& parser,
     std::unique_ptr<cb::ClientBackend> profile_backend,
     std::unique_ptr<LoadManager> manager, uint64_t measurement_request_count,
-    MeasurementMode measurement_mode)
+    MeasurementMode measurement_mode,
+    const uint32_t latency_significant_digits,
+    const bool latency_from_schedule)
     : verbose_(verbose), measurement_window_ms_(measurement_window_ms),
       max_trials_(max_trials), extra_percentile_(extra_percentile),
       percentile_(percentile), latency_threshold_ms_(latency_threshold_ms_),
+      latency_significant_digits_(latency_significant_digits),
+      latency_from_schedule_(latency_from_schedule),
       protocol_(protocol), parser_(parser),
       profile_backend_(std::move(profile_backend)),
       manager_(std::move(manager)),
@@ -712,9 +743,20 @@ InferenceProfiler::Measure(
   RETURN_IF_ERROR(manager_->GetAccumulatedClientStat(&start_stat));
 
   if (!is_count_based) {
-    // Wait for specified time interval in msec
-    std::this_thread::sleep_for(
-        std::chrono::milliseconds((uint64_t)(measurement_window_ms_ * 1.2)));
+    // Wait for specified time interval in msec, collecting the request
+    // timestamps on the way so that the rings of the workers don't fill up
+    const std::chrono::steady_clock::time_point measurement_end =
+        std::chrono::steady_clock::now() +
+        std::chrono::milliseconds((uint64_t)(measurement_window_ms_ * 1.2));
+    std::chrono::steady_clock::time_point now =
+        std::chrono::steady_clock::now();
+    while (now < measurement_end) {
+      std::this_thread::sleep_for((std::min)(
+          std::chrono::steady_clock::duration(kTimestampCollectionInterval),
+          measurement_end - now));
+      manager_->CollectTimestamps();
+      now = std::chrono::steady_clock::now();
+    }
     measurement_window_ms = measurement_window_ms_;
   } else {
     std::chrono::milliseconds measurement_window_start =
@@ -724,8 +766,8 @@ InferenceProfiler::Measure(
       // Check the health of the worker threads.
       RETURN_IF_ERROR(manager_->CheckHealth());
 
-      // Wait for 1s until enough samples have been collected.
-      std::this_thread::sleep_for(std::chrono::milliseconds((uint64_t)1000));
+      // Wait until enough samples have been collected.
+      std::this_thread::sleep_for(kTimestampCollectionInterval);
     } while (manager_->CountCollectedRequests() < measurement_window);
 
     std::chrono::milliseconds measurement_window_end =
@@ -767,15 +809,21 @@ InferenceProfiler::Summarize(
   // Get measurement from requests that fall within the time interval
   std::pair<uint64_t, uint64_t> valid_range;
   MeasurementTimestamp(timestamps, &valid_range, measurement_window_ms);
-  std::vector<uint64_t> latencies;
+  HdrHistogram latencies(latency_significant_digits_);
+  HdrHistogram schedule_lateness(latency_significant_digits_);
+  HdrHistogram latencies_from_schedule(latency_significant_digits_);
   ValidLatencyMeasurement(
       timestamps, valid_range, valid_sequence_count, delayed_request_count,
-      &latencies);
+      &latencies, &schedule_lateness,
+      latency_from_schedule_ ? &latencies_from_schedule : nullptr);
 
   RETURN_IF_ERROR(SummarizeLatency(latencies, summary));
+  SummarizeScheduleLateness(schedule_lateness, summary);
+  SummarizeLatencyFromSchedule(latencies_from_schedule, summary);
   RETURN_IF_ERROR(SummarizeClientStat(
       start_stat, end_stat, valid_range.second - valid_range.first,
-      latencies.size(), valid_sequence_count, delayed_request_count, summary));
+      latencies.Count(), valid_sequence_count, delayed_request_count,
+      summary));
 
   if (include_server_stats_) {
     RETURN_IF_ERROR(SummarizeServerStats(
@@ -825,9 +873,14 @@ InferenceProfiler::ValidLatencyMeasurement(
     const TimestampVector& timestamps,
     const std::pair<uint64_t, uint64_t>& valid_range,
     size_t& valid_sequence_count, size_t& delayed_request_count,
-    std::vector<uint64_t>* valid_latencies)
+    HdrHistogram* valid_latencies, HdrHistogram* schedule_lateness,
+    HdrHistogram* latencies_from_schedule)
 {
-  valid_latencies->clear();
+  valid_latencies->Reset();
+  schedule_lateness->Reset();
+  if (latencies_from_schedule != nullptr) {
+    latencies_from_schedule->Reset();
+  }
   valid_sequence_count = 0;
   for (auto& timestamp : timestamps) {
     uint64_t request_start_ns = TIMESPEC_TO_NANOS(std::get<0>(timestamp));
@@ -837,7 +890,15 @@ InferenceProfiler::ValidLatencyMeasurement(
       // Only counting requests that end within the time interval
       if ((request_end_ns >= valid_range.first) &&
           (request_end_ns <= valid_range.second)) {
-        valid_latencies->push_back(request_end_ns - request_start_ns);
+        valid_latencies->Record(request_end_ns - request_start_ns);
+        schedule_lateness->Record(std::get<4>(timestamp));
+        if (latencies_from_schedule != nullptr) {
+          // Count the time the request waited to be sent after its
+          // scheduled time, e.g. behind a stalled server, as a user
+          // issuing it at that time would see it.
+          latencies_from_schedule->Record(
+              request_end_ns - request_start_ns + std::get<4>(timestamp));
+        }
         // Just add the sequence_end flag here.
         if (std::get<2>(timestamp)) {
           valid_sequence_count++;
@@ -848,30 +909,19 @@ InferenceProfiler::ValidLatencyMeasurement(
       }
     }
   }
-
-  // Always sort measured latencies as percentile will be reported as default
-  std::sort(valid_latencies->begin(), valid_latencies->end());
 }
 
 cb::Error
 InferenceProfiler::SummarizeLatency(
-    const std::vector<uint64_t>& latencies, PerfStatus& summary)
+    const HdrHistogram& latencies, PerfStatus& summary)
 {
-  if (latencies.size() == 0) {
+  if (latencies.Count() == 0) {
     return cb::Error(
         "No valid requests recorded within time interval."
         " Please use a larger time window.");
   }
 
-  uint64_t tol_latency_ns = 0;
-  uint64_t tol_square_latency_us = 0;
-
-  for (const auto& latency : latencies) {
-    tol_latency_ns += latency;
-    tol_square_latency_us += (latency * latency) / (1000 * 1000);
-  }
-
-  summary.client_stats.avg_latency_ns = tol_latency_ns / latencies.size();
+  summary.client_stats.avg_latency_ns = latencies.Sum() / latencies.Count();
 
   // retrieve other interesting percentile
   summary.client_stats.percentile_latency_ns.clear();
@@ -881,9 +931,8 @@ InferenceProfiler::SummarizeLatency(
   }
 
   for (const auto percentile : percentiles) {
-    size_t index = (percentile / 100.0) * (latencies.size() - 1) + 0.5;
     summary.client_stats.percentile_latency_ns.emplace(
-        percentile, latencies[index]);
+        percentile, latencies.ValueAtPercentile(percentile));
   }
 
   if (extra_percentile_) {
@@ -893,20 +942,51 @@ InferenceProfiler::SummarizeLatency(
     summary.stabilizing_latency_ns = summary.client_stats.avg_latency_ns;
   }
 
-  // calculate standard deviation
-  uint64_t expected_square_latency_us =
-      tol_square_latency_us / latencies.size();
-  uint64_t square_avg_latency_us = (summary.client_stats.avg_latency_ns *
-                                    summary.client_stats.avg_latency_ns) /
-                                   (1000 * 1000);
-  uint64_t var_us = (expected_square_latency_us > square_avg_latency_us)
-                        ? (expected_square_latency_us - square_avg_latency_us)
-                        : 0;
-  summary.client_stats.std_us = (uint64_t)(sqrt(var_us));
+  summary.client_stats.std_us = (uint64_t)(latencies.StdDev() / 1000);
 
   return cb::Error::Success;
 }
 
+void
+InferenceProfiler::SummarizeScheduleLateness(
+    const HdrHistogram& schedule_lateness, PerfStatus& summary)
+{
+  summary.client_stats.percentile_schedule_lateness_ns.clear();
+  summary.client_stats.max_schedule_lateness_ns = schedule_lateness.Max();
+  summary.client_stats.avg_schedule_lateness_ns =
+      (schedule_lateness.Count() != 0)
+          ? (schedule_lateness.Sum() / schedule_lateness.Count())
+          : 0;
+  // Requests that are not sent on a schedule have no lateness
+  if (schedule_lateness.Max() == 0) {
+    return;
+  }
+  for (const size_t percentile : {50, 90, 99}) {
+    summary.client_stats.percentile_schedule_lateness_ns.emplace(
+        percentile, schedule_lateness.ValueAtPercentile(percentile));
+  }
+}
+
+void
+InferenceProfiler::SummarizeLatencyFromSchedule(
+    const HdrHistogram& latencies_from_schedule, PerfStatus& summary)
+{
+  summary.client_stats.percentile_latency_from_schedule_ns.clear();
+  summary.client_stats.avg_latency_from_schedule_ns = 0;
+  if (latencies_from_schedule.Count() == 0) {
+    return;
+  }
+
+  summary.client_stats.avg_latency_from_schedule_ns =
+      latencies_from_schedule.Sum() / latencies_from_schedule.Count();
+  // Report the same percentiles as the latencies measured from the send time
+  for (const auto& percentile : summary.client_stats.percentile_latency_ns) {
+    summary.client_stats.percentile_latency_from_schedule_ns.emplace(
+        percentile.first,
+        latencies_from_schedule.ValueAtPercentile(percentile.first));
+  }
+}
+
 cb::Error
 InferenceProfiler::SummarizeClientStat(
     const cb::InferStat& start_stat, const cb::InferStat& end_stat,
@@ -28,6 +28,7 @@
 #include <thread>
 #include "concurrency_manager.h"
 #include "custom_load_manager.h"
+#include "hdr_histogram.h"
 #include "model_parser.h"
 #include "request_rate_manager.h"
 
@@ -107,6 +108,15 @@ struct ClientSideStats {
   uint64_t sequence_count;
   // The number of requests that missed their schedule
   uint64_t delayed_request_count;
+  // How late after their scheduled time the requests were sent, only set
+  // when the requests follow a schedule (<percentile, value> pair)
+  std::map<size_t, uint64_t> percentile_schedule_lateness_ns;
+  uint64_t max_schedule_lateness_ns;
+  uint64_t avg_schedule_lateness_ns;
+  // Latency measured from the scheduled time of the requests rather than
+  // from the time they were sent, only set when requested
+  uint64_t avg_latency_from_schedule_ns;
+  std::map<size_t, uint64_t> percentile_latency_from_schedule_ns;
   uint64_t duration_ns;
   uint64_t avg_latency_ns;
   // a ordered map of percentiles to be reported (<percentile, value> pair)
@@ -182,6 +192,10 @@ class InferenceProfiler {
   /// \param measurement_request_count The number of requests to capture when
   /// using "count_windows" mode.
   /// \param measurement_mode The measurement mode to use for windows.
+  /// \param latency_significant_digits The number of significant digits
+  /// the request latencies are summarized with.
+  /// \param latency_from_schedule Whether to also report the latencies
+  /// measured from the scheduled time of the requests.
   /// \return cb::Error object indicating success or
   /// failure.
   static cb::Error Create(
@@ -192,7 +206,9 @@ class InferenceProfiler {
       std::unique_ptr<cb::ClientBackend> profile_backend,
       std::unique_ptr<LoadManager> manager,
       std::unique_ptr<InferenceProfiler>* profiler,
-      uint64_t measurement_request_count, MeasurementMode measurement_mode);
+      uint64_t measurement_request_count, MeasurementMode measurement_mode,
+      const uint32_t latency_significant_digits,
+      const bool latency_from_schedule);
 
   /// Performs the profiling on the given range with the given search algorithm.
   /// For profiling using request rate invoke template with double, otherwise
@@ -266,7 +282,9 @@ class InferenceProfiler {
       std::shared_ptr<ModelParser>& parser,
       std::unique_ptr<cb::ClientBackend> profile_backend,
       std::unique_ptr<LoadManager> manager, uint64_t measurement_request_count,
-      MeasurementMode measurement_mode);
+      MeasurementMode measurement_mode,
+      const uint32_t latency_significant_digits,
+      const bool latency_from_schedule);
 
   /// Actively measure throughput in every 'measurement_window' msec until the
   /// throughput is stable. Once the throughput is stable, it adds the
@@ -362,20 +380,40 @@ class InferenceProfiler {
   /// \param valid_sequence_count Returns the number of completed sequences
   /// during the measurement. A sequence is a set of correlated requests sent to
   /// sequence model.
-  /// \param latencies Returns the vector of request latencies where the
+  /// \param latencies Returns the histogram of request latencies where the
   /// requests are completed within the measurement window.
+  /// \param schedule_lateness Returns the histogram of how late the same
+  /// requests were sent after their scheduled time.
+  /// \param latencies_from_schedule Returns the histogram of the latencies
+  /// of the same requests measured from their scheduled time, if not
+  /// nullptr.
   void ValidLatencyMeasurement(
       const TimestampVector& timestamps,
       const std::pair<uint64_t, uint64_t>& valid_range,
       size_t& valid_sequence_count, size_t& delayed_request_count,
-      std::vector<uint64_t>* latencies);
+      HdrHistogram* latencies, HdrHistogram* schedule_lateness,
+      HdrHistogram* latencies_from_schedule);
 
-  /// \param latencies The vector of request latencies collected.
+  /// \param latencies The histogram of request latencies collected.
   /// \param summary Returns the summary that the latency related fields are
   /// set.
   /// \return cb::Error object indicating success or failure.
   cb::Error SummarizeLatency(
-      const std::vector<uint64_t>& latencies, PerfStatus& summary);
+      const HdrHistogram& latencies, PerfStatus& summary);
+
+  /// \param schedule_lateness The histogram of how late the requests were
+  /// sent after their scheduled time.
+  /// \param summary Returns the summary that the schedule lateness related
+  /// fields are set.
+  void SummarizeScheduleLateness(
+      const HdrHistogram& schedule_lateness, PerfStatus& summary);
+
+  /// \param latencies_from_schedule The histogram of request latencies
+  /// measured from the scheduled time of the requests.
+  /// \param summary Returns the summary that the latency from schedule
+  /// related fields are set.
+  void SummarizeLatencyFromSchedule(
+      const HdrHistogram& latencies_from_schedule, PerfStatus& summary);
 
   /// \param start_stat The accumulated client statistics at the start.
   /// \param end_stat The accumulated client statistics at the end.
@@ -437,6 +475,8 @@ class InferenceProfiler {
   bool extra_percentile_;
   size_t percentile_;
   uint64_t latency_threshold_ms_;
+  uint32_t latency_significant_digits_;
+  bool latency_from_schedule_;
 
   cb::ProtocolType protocol_;
   std::string model_name_;
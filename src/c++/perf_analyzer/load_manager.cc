@@ -151,30 +151,28 @@ LoadManager::CheckHealth()
 cb::Error
 LoadManager::SwapTimestamps(TimestampVector& new_timestamps)
 {
-  TimestampVector total_timestamp;
-  // Gather request timestamps with proper locking from all the worker
-  // threads
-  for (auto& thread_stat : threads_stat_) {
-    std::lock_guard<std::mutex> lock(thread_stat->mu_);
-    total_timestamp.insert(
-        total_timestamp.end(), thread_stat->request_timestamps_.begin(),
-        thread_stat->request_timestamps_.end());
-    thread_stat->request_timestamps_.clear();
-  }
+  CollectTimestamps();
+  new_timestamps.clear();
   // Swap the results
-  total_timestamp.swap(new_timestamps);
+  collected_timestamps_.swap(new_timestamps);
   return cb::Error::Success;
 }
 
-uint64_t
-LoadManager::CountCollectedRequests()
+void
+LoadManager::CollectTimestamps()
 {
-  uint64_t num_of_requests = 0;
+  // The rings are lock-free so this doesn't block the threads recording
+  // new requests
   for (auto& thread_stat : threads_stat_) {
-    std::lock_guard<std::mutex> lock(thread_stat->mu_);
-    num_of_requests += thread_stat->request_timestamps_.size();
+    thread_stat->request_timestamps_.Drain(&collected_timestamps_);
   }
-  return num_of_requests;
+}
+
+uint64_t
+LoadManager::CountCollectedRequests()
+{
+  CollectTimestamps();
+  return collected_timestamps_.size();
 }
 
 cb::Error
@@ -32,6 +32,7 @@
 #include "client_backend/client_backend.h"
 #include "data_loader.h"
 #include "perf_utils.h"
+#include "timestamp_ring.h"
 
 
 namespace triton { namespace perfanalyzer {
@@ -50,6 +51,13 @@ class LoadManager {
   /// \return cb::Error object indicating success or failure.
   cb::Error SwapTimestamps(TimestampVector& new_timestamps);
 
+  /// Move the request timestamps recorded by the worker threads so far to
+  /// the timestamp vector of the load manager, freeing up room in the
+  /// timestamp rings of the workers. Must be called often enough that the
+  /// rings don't fill up during a measurement, from the thread that calls
+  /// SwapTimestamps().
+  void CollectTimestamps();
+
   /// Get the sum of all contexts' stat
   /// \param contexts_stat Returned the accumulated stat from all contexts
   /// in load manager
@@ -66,7 +74,8 @@ class LoadManager {
         "resetting worker threads not supported for this load manager.");
   }
 
-  /// Count the number of requests collected until now.
+  /// Count the number of requests collected until now. Also collects the
+  /// request timestamps as CollectTimestamps() does.
   uint64_t CountCollectedRequests();
 
   /// Wraps the information required to send an inference to the
@@ -105,7 +114,11 @@ class LoadManager {
   /// The properties of an asynchronous request required in
   /// the callback to effectively interpret the response.
   struct AsyncRequestProperties {
-    AsyncRequestProperties() : sequence_end_(false), delayed_(true) {}
+    AsyncRequestProperties()
+        : sequence_end_(false), delayed_(true), schedule_lateness_ns_(0),
+          generation_(0), in_use_(false)
+    {
+    }
     // The id of in the inference context which was used to
     // send this request.
     uint32_t ctx_id_;
@@ -115,6 +128,14 @@ class LoadManager {
     bool sequence_end_;
     // Whether or not the request is delayed as per schedule.
     bool delayed_;
+    // How late after its scheduled time the request was sent.
+    uint64_t schedule_lateness_ns_;
+    // The number of requests that have used this entry when entries are
+    // reused, it tells a response to the current request apart from a
+    // late response to a previous one.
+    uint32_t generation_;
+    // Whether the request is waiting for its first response.
+    bool in_use_;
   };
 
  protected:
@@ -251,10 +272,10 @@ class LoadManager {
     std::vector<cb::InferStat> contexts_stat_;
     // The concurrency level that the worker should produce
     size_t concurrency_;
-    // A vector of request timestamps <start_time, end_time>
+    // A ring of request timestamps <start_time, end_time>
     // Request latency will be end_time - start_time
-    TimestampVector request_timestamps_;
-    // A lock to protect thread data
+    TimestampRing request_timestamps_;
+    // A lock to protect thread data other than the request timestamps
     std::mutex mu_;
   };
 
@@ -281,6 +302,9 @@ class LoadManager {
   std::vector<std::thread> threads_;
   // Contains the statistics on the current working threads
   std::vector<std::shared_ptr<ThreadStat>> threads_stat_;
+  // The request timestamps collected from the worker threads since the
+  // last SwapTimestamps()
+  TimestampVector collected_timestamps_;
 
   // Use condition variable to pause/continue worker threads
   std::condition_variable wake_signal_;
@@ -244,6 +244,9 @@ Usage(char** argv, const std::string& msg = std::string())
                "profiling>"
             << std::endl;
   std::cerr << "\t--percentile <percentile>" << std::endl;
+  std::cerr << "\t--latency-significant-digits <number of digits>"
+            << std::endl;
+  std::cerr << "\t--latency-from-schedule" << std::endl;
   std::cerr << "\tDEPRECATED OPTIONS" << std::endl;
   std::cerr << "\t-t <number of concurrent requests>" << std::endl;
   std::cerr << "\t-c <maximum concurrency>" << std::endl;
@@ -502,6 +505,29 @@ Usage(char** argv, const std::string& msg = std::string())
              "that the average latency is used to determine stability",
              18)
       << std::endl;
+  std::cerr << FormatMessage(
+                   " --latency-significant-digits: The number of significant "
+                   "digits, between 1 and 5, the request latencies are "
+                   "summarized with. The latencies are counted in a histogram "
+                   "to compute the percentiles instead of being copied and "
+                   "sorted. A higher value gives more precise percentiles at "
+                   "the cost of a larger histogram. The default is 3, i.e. a "
+                   "precision of 0.1%.",
+                   18)
+            << std::endl;
+  std::cerr << FormatMessage(
+                   " --latency-from-schedule: Also report the latencies "
+                   "measured from the time each request was scheduled to be "
+                   "sent rather than from the time it was actually sent. "
+                   "When the server stalls, the requests that should have "
+                   "been sent during the stall are sent late and their "
+                   "latency from the send time hides the wait, the latency "
+                   "from schedule includes it. The average delay between "
+                   "the scheduled and the actual send time is reported as "
+                   "well. Only valid with --request-rate-range or "
+                   "--request-intervals.",
+                   18)
+            << std::endl;
   std::cerr << std::endl;
   std::cerr << "II. INPUT DATA OPTIONS: " << std::endl;
   std::cerr << std::setw(9) << std::left
@@ -751,6 +777,8 @@ main(int argc, char** argv)
   // average length of a sentence
   size_t sequence_length = 20;
   int32_t percentile = -1;
+  int32_t latency_significant_digits = 3;
+  bool latency_from_schedule = false;
   uint64_t latency_threshold_ms = pa::NO_LIMIT;
   int32_t batch_size = 1;
   bool using_batch_size = false;
@@ -852,6 +880,8 @@ main(int argc, char** argv)
       {"ssl-https-client-certificate-type", 1, 0, 39},
       {"ssl-https-private-key-file", 1, 0, 40},
       {"ssl-https-private-key-type", 1, 0, 41},
+      {"latency-significant-digits", 1, 0, 42},
+      {"latency-from-schedule", 0, 0, 43},
       {0, 0, 0, 0}};
 
   // Parse commandline...
@@ -1246,6 +1276,17 @@ main(int argc, char** argv)
         }
         break;
       }
+      case 42: {
+        latency_significant_digits = std::atoi(optarg);
+        if ((latency_significant_digits < 1) ||
+            (latency_significant_digits > 5)) {
+          Usage(argv, "--latency-significant-digits must be between 1 and 5");
+        }
+        break;
+      }
+      case 43:
+        latency_from_schedule = true;
+        break;
       case 'v':
         extra_verbose = verbose;
         verbose = true;
@@ -1397,6 +1438,14 @@ main(int argc, char** argv)
         "along with --request-intervals");
   }
 
+  if (latency_from_schedule &&
+      !(using_request_rate_range || using_custom_intervals)) {
+    Usage(
+        argv,
+        "--latency-from-schedule requires --request-rate-range or "
+        "--request-intervals");
+  }
+
   if (((concurrency_range[SEARCH_RANGE::kEND] == pa::NO_LIMIT) ||
        (request_rate_range[SEARCH_RANGE::kEND] ==
         static_cast<double>(pa::NO_LIMIT))) &&
@@ -1673,7 +1722,8 @@ main(int argc, char** argv)
           verbose, stability_threshold, measurement_window_ms, max_trials,
           percentile, latency_threshold_ms, protocol, parser,
           std::move(backend), std::move(manager), &profiler,
-          measurement_request_count, measurement_mode),
+          measurement_request_count, measurement_mode,
+          latency_significant_digits, latency_from_schedule),
       "failed to create profiler");
 
   // pre-run report
@@ -1821,6 +1871,13 @@ main(int argc, char** argv)
            summary[0].client_stats.percentile_latency_ns) {
         ofs << ",p" << percentile.first << " latency";
       }
+      if (latency_from_schedule) {
+        ofs << ",Avg schedule delay";
+        for (const auto& percentile :
+             summary[0].client_stats.percentile_latency_ns) {
+          ofs << ",p" << percentile.first << " latency from schedule";
+        }
+      }
       ofs << std::endl;
 
       // Sort summary results in order of increasing infer/sec.
@@ -1902,6 +1959,13 @@ main(int argc, char** argv)
              status.client_stats.percentile_latency_ns) {
           ofs << "," << (percentile.second / 1000);
         }
+        if (latency_from_schedule) {
+          ofs << "," << (status.client_stats.avg_schedule_lateness_ns / 1000);
+          for (const auto& percentile :
+               status.client_stats.percentile_latency_from_schedule_ns) {
+            ofs << "," << (percentile.second / 1000);
+          }
+        }
         ofs << std::endl;
       }
       ofs.close();
@@ -50,8 +50,9 @@ constexpr uint64_t NANOS_PER_MILLIS = 1000000;
 #define TIMESPEC_TO_MILLIS(TS) (TIMESPEC_TO_NANOS(TS) / pa::NANOS_PER_MILLIS)
 
 //==============================================================================
-using TimestampVector =
-    std::vector<std::tuple<struct timespec, struct timespec, uint32_t, bool>>;
+// <start_time, end_time, sequence_end, delayed, schedule_lateness_ns>
+using TimestampVector = std::vector<
+    std::tuple<struct timespec, struct timespec, uint32_t, bool, uint64_t>>;
 
 // Will use the characters specified here to construct random strings
 std::string const character_set =
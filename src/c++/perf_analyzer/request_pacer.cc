@@ -0,0 +1,98 @@
+// Copyright (c) 2026, NVIDIA CORPORATION. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "request_pacer.h"
+
+#include <algorithm>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+// The bounds of the spin margin. The lower bound covers the cost of waking
+// up when the sleeps are precise, the upper bound caps the CPU spent
+// spinning when they are not.
+constexpr std::chrono::nanoseconds kMinSpinMargin(20000);
+constexpr std::chrono::nanoseconds kMaxSpinMargin(2000000);
+// The margin used before any sleep has been observed, above the default
+// timer slack of Linux.
+constexpr std::chrono::nanoseconds kInitialSpinMargin(100000);
+
+// Hint the CPU that the thread is spinning.
+inline void
+CpuRelax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  _mm_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield");
+#endif
+}
+
+}  // namespace
+
+RequestPacer::RequestPacer() : spin_margin_(kInitialSpinMargin) {}
+
+std::chrono::nanoseconds
+RequestPacer::WaitUntil(const Clock::time_point deadline, bool* missed)
+{
+  Clock::time_point now = Clock::now();
+  *missed = (now > deadline);
+  if ((deadline - now) > spin_margin_) {
+    const Clock::time_point wake_time = deadline - spin_margin_;
+    std::this_thread::sleep_until(wake_time);
+    now = Clock::now();
+    UpdateSpinMargin(now - wake_time);
+  }
+  while (now < deadline) {
+    CpuRelax();
+    now = Clock::now();
+  }
+  return now - deadline;
+}
+
+void
+RequestPacer::UpdateSpinMargin(const std::chrono::nanoseconds oversleep)
+{
+  // Leave twice the observed oversleep at once when a sleep wakes up late,
+  // and shrink slowly back towards it otherwise so that a single precise
+  // wake-up doesn't expose the next wait to the usual slack.
+  const std::chrono::nanoseconds target = 2 * oversleep;
+  if (target > spin_margin_) {
+    spin_margin_ = target;
+  } else {
+    spin_margin_ -= (spin_margin_ - target) / 16;
+  }
+  spin_margin_ =
+      (std::min)((std::max)(spin_margin_, kMinSpinMargin), kMaxSpinMargin);
+}
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,64 @@
+// Copyright (c) 2026, NVIDIA CORPORATION. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <chrono>
+
+namespace triton { namespace perfanalyzer {
+
+//==============================================================================
+/// RequestPacer waits for the scheduled times of requests more precisely
+/// than sleeping does. It sleeps until shortly before the scheduled time and
+/// spins on the clock for the rest of the wait. The margin left for spinning
+/// follows how late the sleeps of the thread actually wake up, so that the
+/// timer slack of the kernel is absorbed by the spin without spinning for
+/// longer than needed. An instance must only be used by one thread.
+///
+class RequestPacer {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  RequestPacer();
+
+  /// Wait until 'deadline'.
+  /// \param deadline The time to wait for.
+  /// \param missed Returns whether 'deadline' had already passed when
+  /// called.
+  /// \return How late after 'deadline' the wait returned.
+  std::chrono::nanoseconds WaitUntil(
+      const Clock::time_point deadline, bool* missed);
+
+  /// \return The current margin left for spinning before a deadline.
+  std::chrono::nanoseconds SpinMargin() const { return spin_margin_; }
+
+ private:
+  // Adjust the spin margin given how late a sleep woke up.
+  void UpdateSpinMargin(const std::chrono::nanoseconds oversleep);
+
+  std::chrono::nanoseconds spin_margin_;
+};
+
+}}  // namespace triton::perfanalyzer
@@ -214,8 +214,8 @@ RequestRateManager::Infer(
   const auto callback_func = [&](cb::InferResult* result) {
     std::shared_ptr<cb::InferResult> result_ptr(result);
     if (thread_stat->cb_status_.IsOk()) {
-      // Add the request timestamp to thread Timestamp vector with
-      // proper locking
+      // The lock protects the request map and the context statistics, the
+      // timestamp ring needs no locking
       std::lock_guard<std::mutex> lock(thread_stat->mu_);
       thread_stat->cb_status_ = result_ptr->RequestStatus();
       if (thread_stat->cb_status_.IsOk()) {
@@ -225,9 +225,9 @@ RequestRateManager::Infer(
         thread_stat->cb_status_ = result_ptr->Id(&request_id);
         const auto& it = async_req_map->find(request_id);
         if (it != async_req_map->end()) {
-          thread_stat->request_timestamps_.emplace_back(std::make_tuple(
+          thread_stat->request_timestamps_.Push(
               it->second.start_time_, end_time_async, it->second.sequence_end_,
-              it->second.delayed_));
+              it->second.delayed_, it->second.schedule_lateness_ns_);
           ctx->infer_backend_->ClientInferStat(
               &(thread_stat->contexts_stat_[0]));
           thread_stat->cb_status_ = ValidateOutputs(*ctx, result);
@@ -267,13 +267,10 @@ RequestRateManager::Infer(
 
     uint32_t seq_id = 0;
 
-    // Sleep if required
-    std::chrono::steady_clock::time_point now =
-        std::chrono::steady_clock::now();
-    std::chrono::nanoseconds wait_time =
-        (schedule_[thread_config->index_] +
-         (thread_config->rounds_ * (*gen_duration_))) -
-        (now - start_time_);
+    // Wait for the scheduled time of the request
+    const std::chrono::steady_clock::time_point scheduled_time =
+        start_time_ + schedule_[thread_config->index_] +
+        (thread_config->rounds_ * (*gen_duration_));
 
     thread_config->index_ = (thread_config->index_ + thread_config->stride_);
     // Loop around the schedule to keep running
@@ -281,11 +278,7 @@ RequestRateManager::Infer(
     thread_config->index_ = thread_config->index_ % schedule_.size();
 
     bool delayed = false;
-    if (wait_time.count() < 0) {
-      delayed = true;
-    } else {
-      std::this_thread::sleep_for(wait_time);
-    }
+    thread_config->pacer_.WaitUntil(scheduled_time, &delayed);
 
     // Update the inputs if required
     if (using_json_data_ && (!on_sequence_model_)) {
@@ -330,14 +323,14 @@ RequestRateManager::Infer(
         }
 
         Request(
-            ctx, request_id++, delayed, callback_func, async_req_map,
-            thread_stat);
+            ctx, request_id++, delayed, scheduled_time, callback_func,
+            async_req_map, thread_stat);
         sequence_stat_[seq_id]->remaining_queries_--;
       }
     } else {
       Request(
-          ctx, request_id++, delayed, callback_func, async_req_map,
-          thread_stat);
+          ctx, request_id++, delayed, scheduled_time, callback_func,
+          async_req_map, thread_stat);
     }
 
     if (early_exit || (!thread_stat->cb_status_.IsOk())) {
@@ -351,7 +344,8 @@ RequestRateManager::Infer(
             ctx->options_->sequence_end_ = true;
             ctx->options_->sequence_id_ = sequence_stat_[i]->seq_id_;
             Request(
-                ctx, request_id++, false /* delayed */, callback_func,
+                ctx, request_id++, false /* delayed */,
+                std::chrono::steady_clock::now(), callback_func,
                 async_req_map, thread_stat);
             sequence_stat_[i]->remaining_queries_ = 0;
           }
@@ -372,11 +366,18 @@ RequestRateManager::Infer(
 void
 RequestRateManager::Request(
     std::shared_ptr<InferContext> context, const uint64_t request_id,
-    const bool delayed, cb::OnCompleteFn callback_func,
+    const bool delayed,
+    const std::chrono::steady_clock::time_point scheduled_time,
+    cb::OnCompleteFn callback_func,
     std::shared_ptr<std::map<std::string, AsyncRequestProperties>>
         async_req_map,
     std::shared_ptr<ThreadStat> thread_stat)
 {
+  // How late after its scheduled time the request is sent
+  const std::chrono::nanoseconds lateness =
+      std::chrono::steady_clock::now() - scheduled_time;
+  const uint64_t schedule_lateness_ns =
+      (lateness.count() > 0) ? lateness.count() : 0;
   if (async_) {
     context->options_->request_id_ = std::to_string(request_id);
     {
@@ -389,6 +390,7 @@ RequestRateManager::Request(
       clock_gettime(CLOCK_MONOTONIC, &(it->second.start_time_));
       it->second.sequence_end_ = context->options_->sequence_end_;
       it->second.delayed_ = delayed;
+      it->second.schedule_lateness_ns_ = schedule_lateness_ns;
     }
     if (streaming_) {
       thread_stat->status_ = context->infer_backend_->AsyncStreamInfer(
@@ -418,13 +420,11 @@ RequestRateManager::Request(
       return;
     }
     clock_gettime(CLOCK_MONOTONIC, &end_time_sync);
+    thread_stat->request_timestamps_.Push(
+        start_time_sync, end_time_sync, context->options_->sequence_end_,
+        delayed, schedule_lateness_ns);
     {
-      // Add the request timestamp to thread Timestamp vector with proper
-      // locking
       std::lock_guard<std::mutex> lock(thread_stat->mu_);
-      thread_stat->request_timestamps_.emplace_back(std::make_tuple(
-          start_time_sync, end_time_sync, context->options_->sequence_end_,
-          delayed));
       thread_stat->status_ = context->infer_backend_->ClientInferStat(
           &(thread_stat->contexts_stat_[0]));
       if (!thread_stat->status_.IsOk()) {
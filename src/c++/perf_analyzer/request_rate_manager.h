@@ -28,6 +28,7 @@
 #include <condition_variable>
 #include <thread>
 #include "load_manager.h"
+#include "request_pacer.h"
 
 namespace triton { namespace perfanalyzer {
 
@@ -116,6 +117,8 @@ class RequestRateManager : public LoadManager {
     bool is_paused_;
     uint64_t rounds_;
     int non_sequence_data_step_id_;
+    // Waits for the scheduled time of each request
+    RequestPacer pacer_;
   };
 
   RequestRateManager(
@@ -149,6 +152,7 @@ class RequestRateManager : public LoadManager {
   /// \param context InferContext to use for sending the request.
   /// \param request_id The unique id to be associated with the request.
   /// \param delayed Whether the request fell behind its scheduled time.
+  /// \param scheduled_time The time the request was scheduled to be sent.
   /// \param callback_func The callback function to use with asynchronous
   /// request.
   /// \param async_req_map The map from ongoing request_id to the
@@ -156,7 +160,9 @@ class RequestRateManager : public LoadManager {
   /// \param thread_stat The runnning status of the worker thread
   void Request(
       std::shared_ptr<InferContext> context, const uint64_t request_id,
-      const bool delayed, cb::OnCompleteFn callback_func,
+      const bool delayed,
+      const std::chrono::steady_clock::time_point scheduled_time,
+      cb::OnCompleteFn callback_func,
       std::shared_ptr<std::map<std::string, AsyncRequestProperties>>
           async_req_map,
       std::shared_ptr<ThreadStat> thread_stat);
@@ -0,0 +1,163 @@
+// Copyright (c) 2026, NVIDIA CORPORATION. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "timestamp_ring.h"
+
+namespace triton { namespace perfanalyzer {
+
+constexpr size_t TimestampRing::kDefaultCapacity;
+constexpr size_t TimestampRing::kCacheLineSize;
+
+namespace {
+
+// The number of cache lines needed for 'count' elements of type T.
+template <typename T>
+size_t
+CacheLinesFor(const size_t count, const size_t cache_line_size)
+{
+  return (count * sizeof(T) + cache_line_size - 1) / cache_line_size;
+}
+
+size_t
+RoundUpToPowerOfTwo(const size_t value)
+{
+  size_t result = 1;
+  while (result < value) {
+    result <<= 1;
+  }
+  return result;
+}
+
+}  // namespace
+
+TimestampRing::TimestampRing(const size_t capacity)
+    : capacity_(RoundUpToPowerOfTwo(capacity)), mask_(capacity_ - 1),
+      turns_(new std::atomic<uint64_t>[capacity_]), tail_(0), head_(0),
+      overflow_count_(0)
+{
+  const size_t time_lines =
+      CacheLinesFor<struct timespec>(capacity_, kCacheLineSize);
+  const size_t lateness_lines =
+      CacheLinesFor<uint64_t>(capacity_, kCacheLineSize);
+  const size_t flag_lines = CacheLinesFor<uint8_t>(capacity_, kCacheLineSize);
+  storage_.reset(
+      new CacheLine[2 * time_lines + lateness_lines + 2 * flag_lines]);
+  size_t offset = 0;
+  start_times_ = reinterpret_cast<struct timespec*>(&storage_[offset]);
+  offset += time_lines;
+  end_times_ = reinterpret_cast<struct timespec*>(&storage_[offset]);
+  offset += time_lines;
+  schedule_lateness_ns_ = reinterpret_cast<uint64_t*>(&storage_[offset]);
+  offset += lateness_lines;
+  sequence_ends_ = reinterpret_cast<uint8_t*>(&storage_[offset]);
+  offset += flag_lines;
+  delayed_ = reinterpret_cast<uint8_t*>(&storage_[offset]);
+  for (size_t i = 0; i < capacity_; ++i) {
+    turns_[i].store(i, std::memory_order_relaxed);
+  }
+}
+
+void
+TimestampRing::Push(
+    const struct timespec& start_time, const struct timespec& end_time,
+    const bool sequence_end, const bool delayed,
+    const uint64_t schedule_lateness_ns)
+{
+  uint64_t position = tail_.load(std::memory_order_relaxed);
+  while (true) {
+    const uint64_t turn =
+        turns_[position & mask_].load(std::memory_order_acquire);
+    if (turn == position) {
+      if (tail_.compare_exchange_weak(
+              position, position + 1, std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (turn < position) {
+      // The slot still holds a record from the previous lap that has not
+      // been drained, the ring is full.
+      std::lock_guard<std::mutex> lock(overflow_mutex_);
+      overflow_.emplace_back(std::make_tuple(
+          start_time, end_time, sequence_end, delayed, schedule_lateness_ns));
+      overflow_count_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    } else {
+      // Another producer took this position first
+      position = tail_.load(std::memory_order_relaxed);
+    }
+  }
+
+  const size_t slot = position & mask_;
+  start_times_[slot] = start_time;
+  end_times_[slot] = end_time;
+  sequence_ends_[slot] = sequence_end;
+  delayed_[slot] = delayed;
+  schedule_lateness_ns_[slot] = schedule_lateness_ns;
+  turns_[slot].store(position + 1, std::memory_order_release);
+}
+
+size_t
+TimestampRing::Drain(TimestampVector* timestamps)
+{
+  uint64_t position = head_.load(std::memory_order_relaxed);
+  const uint64_t tail = tail_.load(std::memory_order_acquire);
+  timestamps->reserve(timestamps->size() + (tail - position));
+
+  size_t count = 0;
+  while (true) {
+    const size_t slot = position & mask_;
+    if (turns_[slot].load(std::memory_order_acquire) != position + 1) {
+      // Not written yet, the remaining records are left for the next drain
+      break;
+    }
+    timestamps->emplace_back(std::make_tuple(
+        start_times_[slot], end_times_[slot], sequence_ends_[slot],
+        delayed_[slot] != 0, schedule_lateness_ns_[slot]));
+    turns_[slot].store(position + capacity_, std::memory_order_release);
+    ++position;
+    ++count;
+  }
+  head_.store(position, std::memory_order_release);
+
+  if (overflow_count_.load(std::memory_order_relaxed) != 0) {
+    std::lock_guard<std::mutex> lock(overflow_mutex_);
+    timestamps->insert(timestamps->end(), overflow_.begin(), overflow_.end());
+    count += overflow_.size();
+    overflow_.clear();
+    overflow_count_.store(0, std::memory_order_relaxed);
+  }
+  return count;
+}
+
+size_t
+TimestampRing::Size() const
+{
+  const uint64_t head = head_.load(std::memory_order_acquire);
+  const uint64_t tail = tail_.load(std::memory_order_acquire);
+  return ((tail > head) ? (tail - head) : 0) +
+         overflow_count_.load(std::memory_order_relaxed);
+}
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,118 @@
+// Copyright (c) 2026, NVIDIA CORPORATION. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <time.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include "perf_utils.h"
+
+namespace triton { namespace perfanalyzer {
+
+//==============================================================================
+/// A fixed-size ring of request timestamps. All the memory is allocated
+/// when the ring is created and each field is kept in its own cache-line
+/// aligned array. Recording and draining the timestamps is lock-free so
+/// that the profiler collecting them never blocks the threads recording
+/// them. A worker thread is usually the only producer, but the callbacks
+/// of asynchronous requests may run on a thread per client, so producers
+/// reserve their slot atomically. The ring is meant to be drained often
+/// enough that it doesn't fill up. If it does, the records that don't fit
+/// are kept in a locked overflow vector rather than dropped.
+///
+class TimestampRing {
+ public:
+  /// The number of records a ring holds by default.
+  static constexpr size_t kDefaultCapacity = (1 << 16);
+
+  /// Create a ring.
+  /// \param capacity The number of records the ring can hold before it is
+  /// drained, rounded up to a power of two.
+  explicit TimestampRing(const size_t capacity = kDefaultCapacity);
+
+  /// Record the timestamps of a request. Safe to call from several
+  /// threads. If the ring is full the record is kept in the overflow.
+  /// \param start_time The time the request was sent.
+  /// \param end_time The time the response was received.
+  /// \param sequence_end Whether the request ends a sequence.
+  /// \param delayed Whether the request was sent later than scheduled.
+  /// \param schedule_lateness_ns How late after its scheduled time the
+  /// request was sent, zero if the request was not scheduled.
+  void Push(
+      const struct timespec& start_time, const struct timespec& end_time,
+      const bool sequence_end, const bool delayed,
+      const uint64_t schedule_lateness_ns);
+
+  /// Move the records stored so far to the end of 'timestamps'. Must not be
+  /// called from more than one thread at a time.
+  /// \param timestamps Returns the records.
+  /// \return The number of records moved.
+  size_t Drain(TimestampVector* timestamps);
+
+  /// \return The number of records stored and not yet drained. The value
+  /// may include records still being written.
+  size_t Size() const;
+
+ private:
+  static constexpr size_t kCacheLineSize = 64;
+
+  struct alignas(kCacheLineSize) CacheLine {
+    uint8_t bytes_[kCacheLineSize];
+  };
+
+  const size_t capacity_;
+  const size_t mask_;
+
+  // A single allocation holding the arrays of fields below, each starting
+  // on its own cache line.
+  std::unique_ptr<CacheLine[]> storage_;
+  struct timespec* start_times_;
+  struct timespec* end_times_;
+  uint64_t* schedule_lateness_ns_;
+  uint8_t* sequence_ends_;
+  uint8_t* delayed_;
+
+  // The position whose record a slot is ready for. A producer may write
+  // the slot at position 'p' once it holds 'p', the consumer may read it
+  // once it holds 'p + 1'.
+  std::unique_ptr<std::atomic<uint64_t>[]> turns_;
+
+  // The next position to be written, shared by the producers.
+  alignas(kCacheLineSize) std::atomic<uint64_t> tail_;
+  // The next position to be read, only advanced by the consumer.
+  alignas(kCacheLineSize) std::atomic<uint64_t> head_;
+
+  // The records that didn't fit in the ring, protected by
+  // 'overflow_mutex_'. Their number is also kept in 'overflow_count_' so
+  // that Size() doesn't take the lock.
+  alignas(kCacheLineSize) std::atomic<uint64_t> overflow_count_;
+  std::mutex overflow_mutex_;
+  TimestampVector overflow_;
+};
+
+}}  // namespace triton::perfanalyzer
@@ -1030,6 +1030,193 @@ TYPED_TEST_P(ClientTest, AsyncInferMultiMismatchOutputs)
   ASSERT_FALSE(err.IsOk()) << "Expect AsyncInferMulti() to fail";
 }
 
+TYPED_TEST_P(ClientTest, PreparedRequest)
+{
+  tc::Error err = tc::Error::Success;
+  tc::InferOptions options(this->model_name_);
+  options.model_version_ = "1";
+
+  std::vector<tc::InferInput*> inputs;
+  err = this->PrepareInputs(
+      this->input_data_[0], this->input_data_[1], &inputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to prepare inputs: " << err.Message();
+
+  std::unique_ptr<tc::PreparedRequest> prepared_request;
+  err = this->client_->PrepareRequest(&prepared_request, options, inputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to prepare request: " << err.Message();
+
+  // Run the prepared request with different input data on each call
+  for (size_t i = 0; i < 3; ++i) {
+    const auto& input_0 = this->input_data_[i % this->input_data_.size()];
+    const auto& input_1 = this->input_data_[(i + 1) % this->input_data_.size()];
+    for (size_t j = 0; j < 2; ++j) {
+      const auto& data = (j == 0) ? input_0 : input_1;
+      inputs[j]->Reset();
+      inputs[j]->AppendRaw(
+          reinterpret_cast<const uint8_t*>(data.data()),
+          data.size() * sizeof(int32_t));
+    }
+    options.request_id_ = std::to_string(i);
+
+    std::vector<tc::InferResult*> results(1);
+    err = this->client_->Infer(&results[0], *prepared_request, options);
+    ASSERT_TRUE(err.IsOk())
+        << "failed to run prepared request: " << err.Message();
+
+    std::string id;
+    err = results[0]->Id(&id);
+    ASSERT_TRUE(err.IsOk()) << "failed to get request id: " << err.Message();
+    EXPECT_EQ(id, options.request_id_);
+
+    std::vector<std::map<std::string, std::vector<int32_t>>> expected_outputs(
+        1);
+    for (size_t k = 0; k < 16; ++k) {
+      expected_outputs[0]["OUTPUT0"].emplace_back(input_0[k] + input_1[k]);
+      expected_outputs[0]["OUTPUT1"].emplace_back(input_0[k] - input_1[k]);
+    }
+    EXPECT_NO_FATAL_FAILURE(this->ValidateOutput(results, expected_outputs));
+    delete results[0];
+  }
+
+  // The byte size of the inputs is part of the prepared request
+  inputs[0]->AppendRaw(
+      reinterpret_cast<const uint8_t*>(this->input_data_[0].data()),
+      sizeof(int32_t));
+  tc::InferResult* result = nullptr;
+  err = this->client_->Infer(&result, *prepared_request, options);
+  ASSERT_FALSE(err.IsOk()) << "Expect Infer() with mismatching input to fail";
+}
+
+TYPED_TEST_P(ClientTest, OutputDestinationBuffer)
+{
+  tc::Error err = tc::Error::Success;
+  tc::InferOptions options(this->model_name_);
+  options.model_version_ = "1";
+
+  std::vector<tc::InferInput*> inputs;
+  err = this->PrepareInputs(
+      this->input_data_[0], this->input_data_[1], &inputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to prepare inputs: " << err.Message();
+
+  // Only OUTPUT0 is written to a destination buffer
+  std::vector<int32_t> destination(16);
+  std::vector<const tc::InferRequestedOutput*> outputs;
+  for (const auto& name : {"OUTPUT0", "OUTPUT1"}) {
+    tc::InferRequestedOutput* output;
+    err = tc::InferRequestedOutput::Create(&output, name);
+    ASSERT_TRUE(err.IsOk()) << "failed to create output: " << err.Message();
+    outputs.emplace_back(output);
+  }
+  err = const_cast<tc::InferRequestedOutput*>(outputs[0])
+            ->SetDestinationBuffer(
+                destination.data(), destination.size() * sizeof(int32_t));
+  ASSERT_TRUE(err.IsOk()) << "failed to set destination buffer: "
+                          << err.Message();
+
+  std::vector<tc::InferResult*> results(1);
+  err = this->client_->Infer(&results[0], options, inputs, outputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to perform inference: " << err.Message();
+
+  std::vector<std::map<std::string, std::vector<int32_t>>> expected_outputs(1);
+  for (size_t k = 0; k < 16; ++k) {
+    expected_outputs[0]["OUTPUT0"].emplace_back(
+        this->input_data_[0][k] + this->input_data_[1][k]);
+    expected_outputs[0]["OUTPUT1"].emplace_back(
+        this->input_data_[0][k] - this->input_data_[1][k]);
+  }
+  EXPECT_NO_FATAL_FAILURE(this->ValidateOutput(results, expected_outputs));
+
+  // The destination buffer is only honored by the HTTP client
+  if (std::is_same<TypeParam, tc::InferenceServerHttpClient>::value) {
+    const uint8_t* buf = nullptr;
+    size_t byte_size = 0;
+    err = results[0]->RawData("OUTPUT0", &buf, &byte_size);
+    ASSERT_TRUE(err.IsOk()) << "failed to get output: " << err.Message();
+    EXPECT_EQ(buf, reinterpret_cast<const uint8_t*>(destination.data()));
+    EXPECT_EQ(destination, expected_outputs[0]["OUTPUT0"]);
+  }
+
+  delete results[0];
+  for (auto output : outputs) {
+    delete output;
+  }
+  for (auto input : inputs) {
+    delete input;
+  }
+}
+
+TYPED_TEST_P(ClientTest, InferBatcher)
+{
+  tc::Error err = tc::Error::Success;
+  // The 3 requests are sent as a single batched request once the batch is
+  // full, the delay is long enough that it doesn't expire first.
+  tc::InferBatcherOptions batcher_options;
+  batcher_options.max_batch_size = 3;
+  batcher_options.max_queue_delay_us = 10000000;
+  std::unique_ptr<tc::InferBatcher> batcher;
+  err = this->client_->CreateInferBatcher(&batcher, batcher_options);
+  ASSERT_TRUE(err.IsOk()) << "failed to create batcher: " << err.Message();
+
+  std::vector<std::vector<tc::InferInput*>> inputs(3);
+  std::vector<std::map<std::string, std::vector<int32_t>>> expected_outputs;
+  std::vector<tc::InferResult*> results(3, nullptr);
+  size_t completed_count = 0;
+  std::condition_variable cv;
+  std::mutex mu;
+  for (size_t i = 0; i < 3; ++i) {
+    const auto& input_0 = this->input_data_[i % this->input_data_.size()];
+    const auto& input_1 = this->input_data_[(i + 1) % this->input_data_.size()];
+    err = this->PrepareInputs(input_0, input_1, &inputs[i]);
+    ASSERT_TRUE(err.IsOk()) << "failed to prepare inputs: " << err.Message();
+
+    expected_outputs.emplace_back();
+    for (size_t k = 0; k < 16; ++k) {
+      expected_outputs.back()["OUTPUT0"].emplace_back(input_0[k] + input_1[k]);
+      expected_outputs.back()["OUTPUT1"].emplace_back(input_0[k] - input_1[k]);
+    }
+
+    tc::InferOptions options(this->model_name_);
+    options.model_version_ = "1";
+    options.request_id_ = std::to_string(i);
+    err = batcher->AsyncInfer(
+        [i, &results, &completed_count, &cv, &mu](tc::InferResult* result) {
+          {
+            std::lock_guard<std::mutex> lk(mu);
+            results[i] = result;
+            ++completed_count;
+          }
+          cv.notify_one();
+        },
+        options, inputs[i]);
+    ASSERT_TRUE(err.IsOk()) << "failed to perform inference: "
+                            << err.Message();
+  }
+
+  {
+    std::unique_lock<std::mutex> lk(mu);
+    cv.wait(lk, [&completed_count] { return (completed_count == 3); });
+  }
+  EXPECT_NO_FATAL_FAILURE(this->ValidateOutput(results, expected_outputs));
+  for (size_t i = 0; i < 3; ++i) {
+    std::string id;
+    err = results[i]->Id(&id);
+    ASSERT_TRUE(err.IsOk()) << "failed to get id: " << err.Message();
+    EXPECT_EQ(id, std::to_string(i));
+    std::vector<int64_t> shape;
+    err = results[i]->Shape("OUTPUT0", &shape);
+    ASSERT_TRUE(err.IsOk()) << "failed to get shape: " << err.Message();
+    EXPECT_EQ(shape, this->shape_);
+  }
+
+  batcher.reset();
+  for (size_t i = 0; i < 3; ++i) {
+    delete results[i];
+    for (auto input : inputs[i]) {
+      delete input;
+    }
+  }
+}
+
 REGISTER_TYPED_TEST_SUITE_P(
     ClientTest, InferMulti, InferMultiDifferentOutputs,
     InferMultiDifferentOptions, InferMultiOneOption, InferMultiOneOutput,
@@ -1037,7 +1224,8 @@ REGISTER_TYPED_TEST_SUITE_P(
     AsyncInferMulti, AsyncInferMultiDifferentOutputs,
     AsyncInferMultiDifferentOptions, AsyncInferMultiOneOption,
     AsyncInferMultiOneOutput, AsyncInferMultiNoOutput,
-    AsyncInferMultiMismatchOptions, AsyncInferMultiMismatchOutputs);
+    AsyncInferMultiMismatchOptions, AsyncInferMultiMismatchOutputs,
+    PreparedRequest, OutputDestinationBuffer, InferBatcher);
 
 INSTANTIATE_TYPED_TEST_SUITE_P(GRPC, ClientTest, tc::InferenceServerGrpcClient);
 INSTANTIATE_TYPED_TEST_SUITE_P(HTTP, ClientTest, tc::InferenceServerHttpClient);
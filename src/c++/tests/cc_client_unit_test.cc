@@ -0,0 +1,484 @@
+// Copyright (c) 2026, NVIDIA CORPORATION. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#include "gtest/gtest.h"
+
+#include <unistd.h>
+#include <zlib.h>
+#include <deque>
+#include <functional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "common.h"
+#include "http_compression.h"
+#include "shm_utils.h"
+
+#ifdef TRITON_ENABLE_ZSTD
+#include <zstd.h>
+#endif  // TRITON_ENABLE_ZSTD
+#ifdef TRITON_ENABLE_LZ4
+#include <lz4frame.h>
+#endif  // TRITON_ENABLE_LZ4
+
+namespace tc = triton::client;
+
+namespace {
+
+// These tests exercise the parts of the client library that don't need a
+// running Triton server.
+
+constexpr size_t kSliceSize = tc::SharedMemoryArena::kSliceAlignment;
+
+class SharedMemoryArenaTest : public ::testing::Test {
+ protected:
+  // Create an arena of 'slice_count' slices of the alignment size
+  void CreateArena(const size_t slice_count)
+  {
+    const std::string key =
+        "/cc_client_unit_test_arena_" + std::to_string(getpid());
+    auto err = tc::SharedMemoryArena::Create(
+        &arena_, "arena", key, slice_count * kSliceSize);
+    ASSERT_TRUE(err.IsOk())
+        << "failed to create shared memory arena: " << err.Message();
+  }
+
+  void Allocate(const size_t byte_size, tc::SharedMemoryArena::Slice* slice)
+  {
+    auto err = arena_->Allocate(byte_size, slice);
+    ASSERT_TRUE(err.IsOk())
+        << "failed to allocate " << byte_size << " bytes: " << err.Message();
+  }
+
+  // Declared first so that it is destroyed after the slices of the tests
+  std::unique_ptr<tc::SharedMemoryArena> arena_;
+};
+
+TEST_F(SharedMemoryArenaTest, AlignsSlices)
+{
+  CreateArena(4);
+  tc::SharedMemoryArena::Slice first, second;
+  Allocate(1, &first);
+  Allocate(kSliceSize + 1, &second);
+  EXPECT_EQ(first.Offset(), 0);
+  EXPECT_EQ(first.ByteSize(), 1);
+  EXPECT_EQ(second.Offset(), kSliceSize);
+  EXPECT_EQ(second.ByteSize(), kSliceSize + 1);
+  EXPECT_EQ(
+      reinterpret_cast<uint8_t*>(second.Data()) -
+          reinterpret_cast<uint8_t*>(first.Data()),
+      kSliceSize);
+
+  // The second slice reserved two aligned blocks, only one is left
+  tc::SharedMemoryArena::Slice third;
+  EXPECT_FALSE(arena_->Allocate(2 * kSliceSize, &third).IsOk());
+  Allocate(kSliceSize, &third);
+  EXPECT_EQ(third.Offset(), 3 * kSliceSize);
+}
+
+TEST_F(SharedMemoryArenaTest, WrapsToOffsetZero)
+{
+  CreateArena(4);
+  tc::SharedMemoryArena::Slice first, second, third;
+  Allocate(kSliceSize, &first);
+  Allocate(kSliceSize, &second);
+  Allocate(kSliceSize, &third);
+
+  // Only one block is left at the end and none before the oldest slice
+  tc::SharedMemoryArena::Slice wrapped;
+  EXPECT_FALSE(arena_->Allocate(2 * kSliceSize, &wrapped).IsOk());
+
+  first.Release();
+  second.Release();
+  // The slice doesn't fit at the end, it is placed at the start of the
+  // region that the released slices gave back.
+  Allocate(2 * kSliceSize, &wrapped);
+  EXPECT_EQ(wrapped.Offset(), 0);
+}
+
+TEST_F(SharedMemoryArenaTest, ExactlyFull)
+{
+  CreateArena(4);
+  tc::SharedMemoryArena::Slice slices[4];
+  for (size_t i = 0; i < 4; ++i) {
+    Allocate(kSliceSize, &slices[i]);
+    EXPECT_EQ(slices[i].Offset(), i * kSliceSize);
+  }
+  tc::SharedMemoryArena::Slice extra;
+  EXPECT_FALSE(arena_->Allocate(1, &extra).IsOk());
+
+  // Wrapping into the space of the oldest slice fills the region again,
+  // the head of the ring is then at its tail.
+  slices[0].Release();
+  Allocate(kSliceSize, &extra);
+  EXPECT_EQ(extra.Offset(), 0);
+  tc::SharedMemoryArena::Slice overflow;
+  EXPECT_FALSE(arena_->Allocate(1, &overflow).IsOk());
+
+  slices[1].Release();
+  Allocate(kSliceSize, &overflow);
+  EXPECT_EQ(overflow.Offset(), kSliceSize);
+}
+
+TEST_F(SharedMemoryArenaTest, OutOfOrderRelease)
+{
+  CreateArena(4);
+  tc::SharedMemoryArena::Slice first, second, third, fourth;
+  Allocate(kSliceSize, &first);
+  Allocate(kSliceSize, &second);
+  Allocate(kSliceSize, &third);
+  Allocate(kSliceSize, &fourth);
+
+  // A slice released before the older ones isn't reclaimed
+  second.Release();
+  third.Release();
+  tc::SharedMemoryArena::Slice slice;
+  EXPECT_FALSE(arena_->Allocate(1, &slice).IsOk());
+
+  // Releasing the oldest slice reclaims the ones released after it
+  first.Release();
+  Allocate(3 * kSliceSize, &slice);
+  EXPECT_EQ(slice.Offset(), 0);
+}
+
+TEST_F(SharedMemoryArenaTest, ResetsWhenEmpty)
+{
+  CreateArena(4);
+  tc::SharedMemoryArena::Slice first, second;
+  Allocate(kSliceSize, &first);
+  Allocate(2 * kSliceSize, &second);
+  first.Release();
+  second.Release();
+
+  // Once empty the next slice starts at the beginning of the region, even
+  // if it would not have fit after the released slices.
+  tc::SharedMemoryArena::Slice whole;
+  Allocate(4 * kSliceSize, &whole);
+  EXPECT_EQ(whole.Offset(), 0);
+}
+
+TEST_F(SharedMemoryArenaTest, UnregistersOnDestruction)
+{
+  const std::string key =
+      "/cc_client_unit_test_arena_" + std::to_string(getpid());
+  size_t register_count = 0;
+  size_t unregister_count = 0;
+  auto err = tc::SharedMemoryArena::Create(
+      &arena_, "arena", key, kSliceSize,
+      [&register_count](
+          const std::string& name, const std::string& /* key */,
+          const size_t byte_size) {
+        EXPECT_EQ(name, "arena");
+        EXPECT_EQ(byte_size, kSliceSize);
+        ++register_count;
+        return tc::Error::Success;
+      },
+      [&unregister_count](const std::string& name) {
+        EXPECT_EQ(name, "arena");
+        ++unregister_count;
+        return tc::Error::Success;
+      });
+  ASSERT_TRUE(err.IsOk())
+      << "failed to create shared memory arena: " << err.Message();
+  EXPECT_EQ(register_count, 1);
+  EXPECT_EQ(unregister_count, 0);
+
+  // The region is unregistered once, by Unregister() or by the destructor
+  EXPECT_TRUE(arena_->Unregister().IsOk());
+  EXPECT_EQ(unregister_count, 1);
+  arena_.reset();
+  EXPECT_EQ(unregister_count, 1);
+}
+
+// Check that 'estimate' is within the error bound of the histogram above
+// the exact percentile 'expected'.
+void
+ExpectPercentile(const uint64_t estimate, const uint64_t expected)
+{
+  EXPECT_GE(estimate, expected);
+  EXPECT_LT(estimate, expected + expected / 16)
+      << "estimate is not within 6.25% of " << expected;
+}
+
+TEST(LatencyHistogramTest, Empty)
+{
+  tc::LatencyHistogram histogram;
+  EXPECT_EQ(histogram.Count(), 0);
+  EXPECT_EQ(histogram.Sum(), 0);
+  const tc::LatencyPercentiles percentiles = histogram.Percentiles();
+  EXPECT_EQ(percentiles.count, 0);
+  EXPECT_EQ(percentiles.p50_ns, 0);
+  EXPECT_EQ(percentiles.p90_ns, 0);
+  EXPECT_EQ(percentiles.p99_ns, 0);
+  EXPECT_EQ(percentiles.max_ns, 0);
+}
+
+TEST(LatencyHistogramTest, SmallValuesAreExact)
+{
+  // The values below the number of sub-buckets have a bucket each
+  tc::LatencyHistogram histogram;
+  for (uint64_t value_ns = 1; value_ns <= 10; ++value_ns) {
+    histogram.Record(value_ns);
+  }
+  EXPECT_EQ(histogram.Count(), 10);
+  EXPECT_EQ(histogram.Sum(), 55);
+  const tc::LatencyPercentiles percentiles = histogram.Percentiles();
+  EXPECT_EQ(percentiles.count, 10);
+  EXPECT_EQ(percentiles.p50_ns, 5);
+  EXPECT_EQ(percentiles.p90_ns, 9);
+  EXPECT_EQ(percentiles.p99_ns, 10);
+  EXPECT_EQ(percentiles.max_ns, 10);
+}
+
+TEST(LatencyHistogramTest, PercentilesWithinErrorBound)
+{
+  // Record 1 us to 10 ms in 1 us steps, in an order that isn't sorted
+  constexpr uint64_t kValueCount = 10000;
+  tc::LatencyHistogram histogram;
+  uint64_t sum_ns = 0;
+  for (uint64_t i = 0; i < kValueCount; ++i) {
+    const uint64_t value_ns = (((i * 7919) % kValueCount) + 1) * 1000;
+    histogram.Record(value_ns);
+    sum_ns += value_ns;
+  }
+  EXPECT_EQ(histogram.Count(), kValueCount);
+  EXPECT_EQ(histogram.Sum(), sum_ns);
+
+  const tc::LatencyPercentiles percentiles = histogram.Percentiles();
+  EXPECT_EQ(percentiles.count, kValueCount);
+  ExpectPercentile(percentiles.p50_ns, 5000 * 1000);
+  ExpectPercentile(percentiles.p90_ns, 9000 * 1000);
+  ExpectPercentile(percentiles.p99_ns, 9900 * 1000);
+  EXPECT_EQ(percentiles.max_ns, kValueCount * 1000);
+}
+
+TEST(LatencyHistogramTest, ValuesBeyondRange)
+{
+  // The latencies beyond the tracked range are reported as the maximum
+  constexpr uint64_t kLargeValue = (uint64_t(1) << 50) + 12345;
+  tc::LatencyHistogram histogram;
+  histogram.Record(1000);
+  histogram.Record(kLargeValue);
+  const tc::LatencyPercentiles percentiles = histogram.Percentiles();
+  ExpectPercentile(percentiles.p50_ns, 1000);
+  EXPECT_EQ(percentiles.p99_ns, kLargeValue);
+  EXPECT_EQ(percentiles.max_ns, kLargeValue);
+}
+
+TEST(LatencyHistogramTest, ConcurrentRecording)
+{
+  // The threads record into different shards, reads merge all of them
+  constexpr size_t kThreadCount = 8;
+  constexpr uint64_t kValuesPerThread = 10000;
+  tc::LatencyHistogram histogram;
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < kThreadCount; ++t) {
+    threads.emplace_back([&histogram, t]() {
+      for (uint64_t i = 0; i < kValuesPerThread; ++i) {
+        histogram.Record((t + 1) * 1000);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(histogram.Count(), kThreadCount * kValuesPerThread);
+  EXPECT_EQ(
+      histogram.Sum(),
+      kValuesPerThread * 1000 * (kThreadCount * (kThreadCount + 1) / 2));
+  const tc::LatencyPercentiles percentiles = histogram.Percentiles();
+  EXPECT_EQ(percentiles.count, kThreadCount * kValuesPerThread);
+  ExpectPercentile(percentiles.p50_ns, 4000);
+  ExpectPercentile(percentiles.p90_ns, 8000);
+  EXPECT_EQ(percentiles.max_ns, kThreadCount * 1000);
+}
+
+class RequestCompressorTest : public ::testing::Test {
+ protected:
+  using CompressionType = tc::InferenceServerHttpClient::CompressionType;
+  using DecompressFn = std::function<void(
+      const std::vector<uint8_t>& compressed, std::vector<uint8_t>* data)>;
+
+  RequestCompressorTest()
+  {
+    // Buffers of various sizes, including an empty one and one larger than
+    // the 64 KB blocks of lz4, filled with data that is only partly
+    // compressible.
+    const size_t buffer_sizes[] = {1, 0, 13, 70000, 4096, 100000};
+    uint32_t state = 12345;
+    for (const size_t buffer_size : buffer_sizes) {
+      buffers_.emplace_back(buffer_size);
+      for (auto& byte : buffers_.back()) {
+        state = state * 1103515245 + 12345;
+        byte = static_cast<uint8_t>('a' + ((state >> 16) % 8));
+      }
+      data_.insert(
+          data_.end(), buffers_.back().begin(), buffers_.back().end());
+    }
+  }
+
+  // Compress the request buffers with a compressor of 'type', pulling the
+  // compressed data through a window of 'window_size' bytes like libcurl
+  // does, decompress it with 'decompress' and check that the data is
+  // unchanged.
+  void ExpectRoundTrip(
+      const CompressionType type, const DecompressFn& decompress)
+  {
+    const size_t window_sizes[] = {1, 7, 100, 16 * 1024, 512 * 1024};
+    for (const size_t window_size : window_sizes) {
+      SCOPED_TRACE("window size " + std::to_string(window_size));
+      std::unique_ptr<tc::RequestCompressor> compressor;
+      auto err = tc::RequestCompressor::Create(type, &compressor);
+      ASSERT_TRUE(err.IsOk())
+          << "failed to create compressor: " << err.Message();
+
+      std::deque<std::pair<uint8_t*, size_t>> source;
+      for (auto& buffer : buffers_) {
+        source.emplace_back(buffer.data(), buffer.size());
+      }
+      std::vector<uint8_t> compressed;
+      std::vector<uint8_t> window(window_size);
+      size_t output_bytes = 0;
+      do {
+        err = compressor->Compress(
+            &source, window.data(), window.size(), &output_bytes);
+        ASSERT_TRUE(err.IsOk()) << "failed to compress: " << err.Message();
+        compressed.insert(
+            compressed.end(), window.begin(), window.begin() + output_bytes);
+      } while (output_bytes == window_size);
+      EXPECT_TRUE(compressor->Finished());
+      EXPECT_LT(compressed.size(), data_.size());
+
+      // Once finished the compressor produces no more data
+      err = compressor->Compress(
+          &source, window.data(), window.size(), &output_bytes);
+      ASSERT_TRUE(err.IsOk()) << "failed to compress: " << err.Message();
+      EXPECT_EQ(output_bytes, 0);
+
+      std::vector<uint8_t> decompressed;
+      decompress(compressed, &decompressed);
+      EXPECT_TRUE(decompressed == data_) << "data changed by round trip";
+    }
+  }
+
+  std::vector<std::vector<uint8_t>> buffers_;
+  // The concatenation of the buffers
+  std::vector<uint8_t> data_;
+};
+
+// Inflate 'compressed' with zlib, detecting whether it is in the zlib
+// (deflate) or gzip format.
+void
+Inflate(const std::vector<uint8_t>& compressed, std::vector<uint8_t>* data)
+{
+  z_stream stream = z_stream();
+  ASSERT_EQ(inflateInit2(&stream, 15 + 32 /* windowBits */), Z_OK);
+  stream.next_in = const_cast<uint8_t*>(compressed.data());
+  stream.avail_in = compressed.size();
+  uint8_t chunk[4096];
+  int ret = Z_OK;
+  while (ret == Z_OK) {
+    stream.next_out = chunk;
+    stream.avail_out = sizeof(chunk);
+    ret = inflate(&stream, Z_NO_FLUSH);
+    data->insert(data->end(), chunk, chunk + sizeof(chunk) - stream.avail_out);
+  }
+  inflateEnd(&stream);
+  EXPECT_EQ(ret, Z_STREAM_END);
+  EXPECT_EQ(stream.avail_in, 0);
+}
+
+TEST_F(RequestCompressorTest, Deflate)
+{
+  ExpectRoundTrip(CompressionType::DEFLATE, Inflate);
+}
+
+TEST_F(RequestCompressorTest, Gzip)
+{
+  ExpectRoundTrip(CompressionType::GZIP, Inflate);
+}
+
+#ifdef TRITON_ENABLE_ZSTD
+TEST_F(RequestCompressorTest, Zstd)
+{
+  ExpectRoundTrip(
+      CompressionType::ZSTD,
+      [](const std::vector<uint8_t>& compressed, std::vector<uint8_t>* data) {
+        ZSTD_DCtx* dctx = ZSTD_createDCtx();
+        ASSERT_NE(dctx, nullptr);
+        ZSTD_inBuffer input{compressed.data(), compressed.size(), 0};
+        uint8_t chunk[4096];
+        size_t ret = 1;
+        while ((ret != 0) && !ZSTD_isError(ret)) {
+          ZSTD_outBuffer output{chunk, sizeof(chunk), 0};
+          ret = ZSTD_decompressStream(dctx, &output, &input);
+          data->insert(data->end(), chunk, chunk + output.pos);
+        }
+        ZSTD_freeDCtx(dctx);
+        EXPECT_EQ(ret, 0) << "failed to decompress zstd data";
+        EXPECT_EQ(input.pos, compressed.size());
+      });
+}
+#endif  // TRITON_ENABLE_ZSTD
+
+#ifdef TRITON_ENABLE_LZ4
+TEST_F(RequestCompressorTest, Lz4)
+{
+  ExpectRoundTrip(
+      CompressionType::LZ4,
+      [](const std::vector<uint8_t>& compressed, std::vector<uint8_t>* data) {
+        LZ4F_dctx* dctx = nullptr;
+        ASSERT_FALSE(LZ4F_isError(
+            LZ4F_createDecompressionContext(&dctx, LZ4F_VERSION)));
+        const uint8_t* src = compressed.data();
+        size_t src_remaining = compressed.size();
+        uint8_t chunk[4096];
+        size_t ret = 1;
+        while ((ret != 0) && !LZ4F_isError(ret)) {
+          size_t dst_size = sizeof(chunk);
+          size_t src_size = src_remaining;
+          ret = LZ4F_decompress(
+              dctx, chunk, &dst_size, src, &src_size, nullptr);
+          data->insert(data->end(), chunk, chunk + dst_size);
+          src += src_size;
+          src_remaining -= src_size;
+        }
+        LZ4F_freeDecompressionContext(dctx);
+        EXPECT_EQ(ret, 0) << "failed to decompress lz4 data";
+        EXPECT_EQ(src_remaining, 0);
+      });
+}
+#endif  // TRITON_ENABLE_LZ4
+
+}  // namespace
+
+int
+main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}